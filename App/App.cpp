@@ -22,6 +22,7 @@ wxDEFINE_EVENT(DELAY_LOAD, wxCommandEvent);
 wxDEFINE_EVENT(OPEN_PACKAGE, wxCommandEvent);
 wxDEFINE_EVENT(LOAD_CORE_ERROR, wxCommandEvent);
 wxDEFINE_EVENT(OBJECT_LOADED, wxCommandEvent);
+wxDEFINE_EVENT(OBJECT_LOAD_FAILED, wxCommandEvent);
 wxDEFINE_EVENT(REGISTER_MIME, wxCommandEvent);
 wxDEFINE_EVENT(UNREGISTER_MIME, wxCommandEvent);
 
@@ -49,6 +50,14 @@ void RegisterFileType(const wxString& extension, const wxString& description, co
   }
 }
 
+// Open requests may point to an object inside of the package: "C:\Dir\Package.gpk|Package.Outer.Object"
+void SplitObjectLink(const wxString& link, wxString& path, wxString& selection)
+{
+  const size_t pos = link.find('|');
+  path = link.substr(0, pos);
+  selection = pos == wxString::npos ? wxString() : link.substr(pos + 1);
+}
+
 void UnregisterFileType(const wxString& extension, wxMimeTypesManager& man)
 {
   if (wxFileType* type = man.GetFileTypeFromExtension(extension))
@@ -185,7 +194,10 @@ wxSize App::GetLastWindowPropSash() const
 
 void App::OnOpenPackage(wxCommandEvent& e)
 {
-  OpenPackage(e.GetString());
+  wxString path;
+  wxString selection;
+  SplitObjectLink(e.GetString(), path, selection);
+  OpenPackage(path, selection);
 }
 
 void App::OnShowSettings(wxCommandEvent& e)
@@ -331,7 +343,7 @@ bool App::OpenPackage(const wxString& path, const wxString selection)
 
   if (!package->IsReady())
   {
-    std::thread([package, window]() {
+    std::thread([package, window, selection]() {
       try
       {
         package->Load();
@@ -357,6 +369,10 @@ bool App::OpenPackage(const wxString& path, const wxString selection)
       if (!package->IsOperationCancelled())
       {
         SendEvent(window, PACKAGE_READY);
+        if (selection.size())
+        {
+          SendEvent(window, SELECT_OBJECT, selection);
+        }
       }
     }).detach();
   }
@@ -716,9 +732,12 @@ void App::DelayLoad(wxCommandEvent&)
       return;
     }
   }
-  for (const wxString& path : OpenList)
+  for (const wxString& link : OpenList)
   {
-    if (OpenPackage(path))
+    wxString path;
+    wxString selection;
+    SplitObjectLink(link, path, selection);
+    if (OpenPackage(path, selection))
     {
       anyLoaded = true;
     }
@@ -815,6 +834,18 @@ void App::OnObjectLoaded(wxCommandEvent& e)
   }
 }
 
+void App::OnObjectLoadFailed(wxCommandEvent& e)
+{
+  std::string id = e.GetString().ToStdString();
+  for (PackageWindow* win : PackageWindows)
+  {
+    if (win->OnObjectLoadFailed(id))
+    {
+      return;
+    }
+  }
+}
+
 void App::OnRegisterMime(wxCommandEvent&)
 {
   wxString appPath = argv[0];
@@ -872,6 +903,7 @@ EVT_COMMAND(wxID_ANY, DELAY_LOAD, App::DelayLoad)
 EVT_COMMAND(wxID_ANY, OPEN_PACKAGE, App::OnOpenPackage)
 EVT_COMMAND(wxID_ANY, LOAD_CORE_ERROR, App::OnLoadError)
 EVT_COMMAND(wxID_ANY, OBJECT_LOADED, App::OnObjectLoaded)
+EVT_COMMAND(wxID_ANY, OBJECT_LOAD_FAILED, App::OnObjectLoadFailed)
 EVT_COMMAND(wxID_ANY, REGISTER_MIME, App::OnRegisterMime)
 EVT_COMMAND(wxID_ANY, UNREGISTER_MIME, App::OnUnregisterMime)
 wxEND_EVENT_TABLE()
\ No newline at end of file
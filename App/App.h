@@ -43,6 +43,7 @@ wxDECLARE_EVENT(DELAY_LOAD, wxCommandEvent);
 wxDECLARE_EVENT(OPEN_PACKAGE, wxCommandEvent);
 wxDECLARE_EVENT(LOAD_CORE_ERROR, wxCommandEvent);
 wxDECLARE_EVENT(OBJECT_LOADED, wxCommandEvent);
+wxDECLARE_EVENT(OBJECT_LOAD_FAILED, wxCommandEvent);
 wxDECLARE_EVENT(REGISTER_MIME, wxCommandEvent);
 wxDECLARE_EVENT(UNREGISTER_MIME, wxCommandEvent);
 
@@ -106,6 +107,7 @@ private:
   void OnLoadError(wxCommandEvent& e);
   bool OnCmdLineParsed(wxCmdLineParser& parser);
   void OnObjectLoaded(wxCommandEvent& e);
+  void OnObjectLoadFailed(wxCommandEvent& e);
 
   // Build DirCache and load class packages
   void LoadCore(ProgressWindow*);
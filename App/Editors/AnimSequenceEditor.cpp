@@ -0,0 +1,69 @@
+#include "AnimSequenceEditor.h"
+
+#include <fstream>
+
+enum ExportMode {
+  ExportKeys = wxID_HIGHEST + 1,
+  ExportData
+};
+
+void AnimSequenceEditor::OnExportClicked(wxCommandEvent& e)
+{
+  wxMenu menu;
+  menu.Append(ExportMode::ExportKeys, wxT("Sampled keys"));
+  menu.Append(ExportMode::ExportData, wxT("Object data..."));
+  switch (GetPopupMenuSelectionFromUser(menu))
+  {
+  case ExportMode::ExportKeys:
+    break;
+  case ExportMode::ExportData:
+    GenericEditor::OnExportClicked(e);
+    return;
+  default:
+    return;
+  }
+
+  UAnimSequence* sequence = (UAnimSequence*)Object;
+  const int32 numTracks = sequence->GetNumCompressedTracks();
+  if (!numTracks)
+  {
+    wxMessageBox(wxT("The sequence has no tracks!"), wxT("Error!"), wxICON_ERROR);
+    return;
+  }
+
+  // Decode all frames before asking for a path. Per-track compression is not supported
+  const int32 numFrames = std::max<int32>(sequence->NumFrames, 1);
+  std::vector<FAnimTrackSample> samples(numTracks * numFrames);
+  for (int32 frame = 0; frame < numFrames; ++frame)
+  {
+    const float time = numFrames > 1 ? sequence->SequenceDuration * frame / (numFrames - 1) : 0.f;
+    if (!sequence->SampleCompressedTracks(time, 0, numTracks, &samples[frame * numTracks]))
+    {
+      wxMessageBox(wxT("Failed to decode the sequence. The compression format is not supported!"), wxT("Error!"), wxICON_ERROR);
+      return;
+    }
+  }
+
+  wxString path = wxSaveFileSelector("animation keys", ".txt", Object->GetObjectName().WString(), this);
+  if (path.empty())
+  {
+    return;
+  }
+  std::ofstream s(path.ToStdWstring(), std::ios::out | std::ios::trunc);
+  if (!s.is_open())
+  {
+    wxMessageBox("Failed to create/open \"" + path + "\"", "Error!", wxICON_ERROR);
+    return;
+  }
+  s << "# Frame Track TX TY TZ QX QY QZ QW\n";
+  for (int32 frame = 0; frame < numFrames; ++frame)
+  {
+    for (int32 track = 0; track < numTracks; ++track)
+    {
+      const FAnimTrackSample& sample = samples[frame * numTracks + track];
+      s << frame << ' ' << track << ' ';
+      s << sample.Translation.X << ' ' << sample.Translation.Y << ' ' << sample.Translation.Z << ' ';
+      s << sample.Rotation.X << ' ' << sample.Rotation.Y << ' ' << sample.Rotation.Z << ' ' << sample.Rotation.W << '\n';
+    }
+  }
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include "GenericEditor.h"
+#include <Tera/UAnimSequence.h>
+
+class AnimSequenceEditor : public GenericEditor {
+public:
+  using GenericEditor::GenericEditor;
+
+  void OnExportClicked(wxCommandEvent& e) override;
+};
@@ -7,6 +7,8 @@
 #include <Tera/FStream.h>
 #include <Tera/FPackage.h>
 
+#include <Utils/ObjectLoader.h>
+
 #include "ObjectRedirectorEditor.h"
 #include "TextureEditor.h"
 #include "SkelMeshEditor.h"
@@ -16,6 +18,7 @@
 #include "ClassEditor.h"
 #include "LevelEditor.h"
 #include "SpeedTreeEditor.h"
+#include "AnimSequenceEditor.h"
 #include "MaterialEditor.h"
 #include "MaterialInstanceEditor.h"
 
@@ -65,6 +68,10 @@ GenericEditor* GenericEditor::CreateEditor(wxPanel* parent, PackageWindow* windo
   {
     editor = new SpeedTreeEditor(parent, window);
   }
+  else if (c == UAnimSequence::StaticClassName())
+  {
+    editor = new AnimSequenceEditor(parent, window);
+  }
   else if (c == UMaterial::StaticClassName())
   {
     editor = new MaterialEditor(parent, window);
@@ -98,15 +105,9 @@ void GenericEditor::LoadObject()
   if (!Object->IsLoaded())
   {
     Loading = true;
-    UObject* obj = Object;
-    std::weak_ptr<FPackage> wpackage = Window->GetPackage();
-    std::thread([obj, id, wpackage] {
-      if (auto l = wpackage.lock())
-      {
-        obj->Load();
-        SendEvent(wxTheApp, OBJECT_LOADED, id);
-      }
-    }).detach();
+    LoadRequest = ObjectLoader::Get().Load(Window->GetPackage(), Object, LoadPriority::Immediate, [id](UObject*, bool loaded) {
+      SendEvent(wxTheApp, loaded ? OBJECT_LOADED : OBJECT_LOAD_FAILED, id);
+    });
     // TODO: some UI progress?
   }
   else
@@ -115,9 +116,26 @@ void GenericEditor::LoadObject()
   }
 }
 
+void GenericEditor::CancelLoading()
+{
+  // Only a queued load can be cancelled. A running one will send OBJECT_LOADED or OBJECT_LOAD_FAILED
+  if (LoadRequest && LoadRequest->Cancel())
+  {
+    Loading = false;
+  }
+  LoadRequest = nullptr;
+}
+
 void GenericEditor::OnObjectLoaded()
 {
   Loading = false;
+  LoadRequest = nullptr;
+}
+
+void GenericEditor::OnObjectLoadFailed()
+{
+  Loading = false;
+  LoadRequest = nullptr;
 }
 
 std::string GenericEditor::GetEditorId() const
@@ -223,13 +241,12 @@ void GenericEditor::OnExportClicked(wxCommandEvent& e)
     return;
   }
 
-  FReadStream rs = FReadStream(A2W(Object->GetPackage()->GetDataPath()));
-  rs.SetPackage(Object->GetPackage());
-  rs.SetLoadSerializedObjects(Object->GetPackage()->GetStream().GetLoadSerializedObjects());
-  rs.SetPosition(start);
+  std::unique_ptr<FStream> rs = Object->GetPackage()->CreateDataStream();
+  rs->SetLoadSerializedObjects(Object->GetPackage()->GetStream().GetLoadSerializedObjects());
+  rs->SetPosition(start);
 
   void* data = malloc(size);
-  rs.SerializeBytes(data, size);
+  rs->SerializeBytes(data, size);
   s.SerializeBytes(data, size);
 
   if (!s.IsGood())
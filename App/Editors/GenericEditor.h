@@ -2,6 +2,8 @@
 #include <wx/wx.h>
 #include <Tera/FPropertyTag.h>
 
+#include <memory>
+
 enum ToolEventID : int {
   eID_Export = 0,
   eID_Import,
@@ -17,6 +19,7 @@ enum ToolEventID : int {
 
 class UObject;
 class PackageWindow;
+class ObjectLoadRequest;
 class GenericEditor : public wxPanel
 {
 public:
@@ -25,7 +28,13 @@ public:
 
   virtual void LoadObject();
 
+  // Drop the load if it didn't start yet
+  void CancelLoading();
+
   virtual void OnObjectLoaded();
+
+  // The object failed to load. Allows to try again.
+  virtual void OnObjectLoadFailed();
   
   virtual UObject* GetObject()
   {
@@ -78,4 +87,5 @@ protected:
   PackageWindow* Window = nullptr;
   bool Loading = false;
   bool NeedsUpdate = false;
+  std::shared_ptr<ObjectLoadRequest> LoadRequest;
 };
\ No newline at end of file
@@ -93,57 +93,68 @@ void LevelEditor::CreateLevel(ULevel* level, osg::Geode* root)
   {
     return;
   }
+  SceneAssembler scene;
+  scene.AddLevel(level, FString());
+  CreateScene(scene, root);
+}
 
-  auto actors = level->GetActors();
-
-  if (actors.empty())
-  {
-    return;
-  }
-
+void LevelEditor::CreateScene(const SceneAssembler& scene, osg::Geode* root)
+{
   static const osg::Vec3d yawAxis(0.0, 0.0, -1.0);
   static const osg::Vec3d pitchAxis(-1.0, 0.0, 0.0);
   static const osg::Vec3d rollAxis(0.0, -1.0, 0.0);
 
-  for (UActor* actor : actors)
+  // Decode every unique texture once
+  std::vector<osg::ref_ptr<osg::Texture2D>> textures;
+  for (UTexture2D* tex : scene.GetTextures())
   {
-    if (!actor)
+    osg::ref_ptr<osg::Image> img = new osg::Image;
+    if (!tex->RenderTo(img.get()))
     {
+      textures.push_back(nullptr);
       continue;
     }
+    osg::ref_ptr<osg::Texture2D> osgtex = new osg::Texture2D(img);
+    osgtex->setWrap(osg::Texture::WrapParameter::WRAP_S, osg::Texture::WrapMode::REPEAT);
+    osgtex->setWrap(osg::Texture::WrapParameter::WRAP_T, osg::Texture::WrapMode::REPEAT);
+    textures.push_back(osgtex);
+  }
+
+  // Build every unique mesh once. Instances reference the same node.
+  std::vector<osg::ref_ptr<osg::Geode>> meshes;
+  for (const SceneMesh& mesh : scene.GetMeshes())
+  {
+    meshes.push_back(CreateMesh(mesh, textures));
+  }
 
-    osg::Geode* geode = nullptr;
-    FVector compTranslation;
-    FRotator compRotation;
-    FVector compScale3D;
-    float compScale = 1.;
-    if (UStaticMeshActor* a = Cast<UStaticMeshActor>(actor))
+  const std::vector<SceneInstance>& instances = scene.GetInstances();
+  for (const SceneLevel& level : scene.GetLevels())
+  {
+    osg::Geode* levelRoot = root;
+    if (level.Name.Size())
     {
-      geode = CreateStaticActor(a, compTranslation, compScale3D, compRotation, compScale);
+      levelRoot = new osg::Geode;
+      levelRoot->setName(level.Name.UTF8().c_str());
+      root->addChild(levelRoot);
     }
-
-    if (geode)
+    for (int32 instanceIndex : level.Instances)
     {
-      geode->setName(actor->GetObjectName().UTF8().c_str());
+      const SceneInstance& instance = instances[instanceIndex];
       osg::PositionAttitudeTransform* transform = new osg::PositionAttitudeTransform;
-      transform->addChild(geode);
-      transform->setPosition(osg::Vec3(actor->Location.X + compTranslation.X,
-        -(actor->Location.Y + compTranslation.Y),
-        actor->Location.Z + compTranslation.Z));
-      transform->setScale(osg::Vec3(actor->DrawScale3D.X * actor->DrawScale * compScale3D.X * compScale,
-        actor->DrawScale3D.Y * actor->DrawScale * compScale3D.Y * compScale,
-        actor->DrawScale3D.Z * actor->DrawScale * compScale3D.Z * compScale));
+      transform->setName(instance.Actor->GetObjectName().UTF8().c_str());
+      transform->addChild(meshes[instance.MeshIndex].get());
+      transform->setPosition(osg::Vec3(instance.Location.X, -instance.Location.Y, instance.Location.Z));
+      transform->setScale(osg::Vec3(instance.Scale3D.X, instance.Scale3D.Y, instance.Scale3D.Z));
 
       osg::Quat quat;
-      FRotator rot = actor->Rotation + compRotation;
-      FVector euler = rot.Normalized().Euler(); // {X: Roll, Y: Pitch, Z: Yaw}
+      FVector euler = instance.Rotation.Normalized().Euler(); // {X: Roll, Y: Pitch, Z: Yaw}
       quat.makeRotate(
         euler.X * M_PI / 180., pitchAxis,
         euler.Y * M_PI / 180., rollAxis,
         euler.Z * M_PI / 180., yawAxis
       );
       transform->setAttitude(quat);
-      root->addChild(transform);
+      levelRoot->addChild(transform);
     }
   }
 }
@@ -159,24 +170,40 @@ void LevelEditor::OnIdle(wxIdleEvent& e)
   progress.Layout();
 
   std::thread([&] {
-    CreateLevel(Level, Root.get());
+    SceneAssembler scene;
+    scene.AddLevel(Level, FString());
     UObject* world = Level->GetOuter();
     auto worldInner = world->GetInner();
 
+    std::vector<ULevelStreaming*> streamingLevels;
     for (UObject* inner : worldInner)
     {
       if (ULevelStreaming* level = Cast<ULevelStreaming>(inner))
       {
-        level->Load();
-        if (level->Level)
-        {
-          osg::Geode* geode = new osg::Geode;
-          geode->setName(level->Level->GetPackage()->GetPackageName().C_str());
-          CreateLevel(level->Level, geode);
-          Root->addChild(geode);
-        }
+        streamingLevels.push_back(level);
+      }
+    }
+
+    if (streamingLevels.size())
+    {
+      SendEvent(&progress, UPDATE_MAX_PROGRESS, (int32)streamingLevels.size());
+      SendEvent(&progress, UPDATE_PROGRESS, 0);
+      ULevelStreaming::LoadStreamingLevels(streamingLevels, [&](ULevelStreaming* level, int32 loaded) {
+        SendEvent(&progress, UPDATE_PROGRESS_DESC, wxString::Format("Loaded %s (%d/%d)", level->PackageName.C_str(), loaded, (int32)streamingLevels.size()));
+        SendEvent(&progress, UPDATE_PROGRESS, loaded);
+      });
+    }
+
+    // Merge in the world order so the scene does not depend on the load order
+    SendEvent(&progress, UPDATE_PROGRESS_DESC, wxT("Building the scene..."));
+    for (ULevelStreaming* level : streamingLevels)
+    {
+      if (level->Level)
+      {
+        scene.AddLevel(level->Level, level->Level->GetPackage()->GetPackageName());
       }
     }
+    CreateScene(scene, Root.get());
     SendEvent(&progress, UPDATE_PROGRESS_FINISH, true);
   }).detach();
 
@@ -186,95 +213,42 @@ void LevelEditor::OnIdle(wxIdleEvent& e)
   Renderer->setSceneData(Root.get());
 }
 
-osg::Geode* LevelEditor::CreateStaticActor(UStaticMeshActor* actor, FVector& translation, FVector& scale3d, FRotator& rotation, float& scale)
+osg::Geode* LevelEditor::CreateMesh(const SceneMesh& mesh, const std::vector<osg::ref_ptr<osg::Texture2D>>& textures)
 {
-  if (!actor->StaticMeshComponent)
-  {
-    return nullptr;
-  }
-  UStaticMeshComponent* component = actor->StaticMeshComponent;
-  UStaticMesh* mesh = nullptr;
-
-  // TODO: not sure what should be replaced. The component or its model?
-  if (component->ReplacementPrimitive)
-  {
-    UStaticMeshComponent* replacement = Cast<UStaticMeshComponent>(component->ReplacementPrimitive);
-    if (replacement && replacement->StaticMesh)
-    {
-      mesh = replacement->StaticMesh;
-    }
-    else
-    {
-      mesh = component->StaticMesh;
-    }
-  }
-  else
-  {
-    mesh = component->StaticMesh;
-  }
-
-  if (!mesh)
-  {
-    return nullptr;
-  }
-
-  translation = component->Translation;
-  scale3d = component->Scale3D;
-  rotation = component->Rotation;
-  scale = component->Scale;
-
-  const FStaticMeshRenderData* model = mesh->GetLod(0);
-
   osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array;
   osg::ref_ptr<osg::Vec3Array> normals = new osg::Vec3Array(osg::Array::BIND_PER_VERTEX);
   osg::ref_ptr<osg::Vec2Array> uvs = new osg::Vec2Array(osg::Array::BIND_PER_VERTEX);
+  vertices->reserve(mesh.Positions.size());
+  normals->reserve(mesh.Normals.size());
+  uvs->reserve(mesh.UVs.size());
 
-  std::vector<FStaticVertex> uvertices = model->GetVertices();
-  for (auto & uvertex : uvertices)
+  for (size_t idx = 0; idx < mesh.Positions.size(); ++idx)
   {
-    FVector normal = uvertex.TangentZ;
+    const FVector& position = mesh.Positions[idx];
+    const FVector& normal = mesh.Normals[idx];
+    vertices->push_back(osg::Vec3(position.X, -position.Y, position.Z));
     normals->push_back(osg::Vec3(normal.X, -normal.Y, normal.Z));
-    vertices->push_back(osg::Vec3(uvertex.Position.X, -uvertex.Position.Y, uvertex.Position.Z));
-    uvs->push_back(osg::Vec2(uvertex.UVs[0].X, uvertex.UVs[0].Y));
+    uvs->push_back(osg::Vec2(mesh.UVs[idx].X, mesh.UVs[idx].Y));
   }
 
   osg::Geode* result = new osg::Geode;
-  std::vector<FStaticMeshElement> elements = model->GetElements();
-  const FRawIndexBuffer& indexContainer = model->IndexBuffer;
-  for (const FStaticMeshElement& section : elements)
+  result->setName(mesh.Mesh->GetObjectName().UTF8().c_str());
+  for (const SceneMeshSection& section : mesh.Sections)
   {
-    if (!section.NumTriangles)
-    {
-      continue;
-    }
     osg::Geometry* geo = new osg::Geometry;
-    osg::ref_ptr<osg::DrawElementsUInt> indices = new osg::DrawElementsUInt(GL_TRIANGLES);
-    for (int32 faceIndex = 0; faceIndex < section.NumTriangles; ++faceIndex)
-    {
-      indices->push_back(indexContainer.GetIndex(section.FirstIndex + (faceIndex * 3) + 0));
-      indices->push_back(indexContainer.GetIndex(section.FirstIndex + (faceIndex * 3) + 1));
-      indices->push_back(indexContainer.GetIndex(section.FirstIndex + (faceIndex * 3) + 2));
-    }
+    osg::ref_ptr<osg::DrawElementsUInt> indices = new osg::DrawElementsUInt(GL_TRIANGLES, section.Indices.begin(), section.Indices.end());
     geo->addPrimitiveSet(indices.get());
     geo->setVertexArray(vertices.get());
     geo->setNormalArray(normals.get());
     geo->setTexCoordArray(0, uvs.get());
 
-    if (UMaterialInterface* material = Cast<UMaterialInterface>(section.Material))
+    if (section.TextureIndex != INDEX_NONE && textures[section.TextureIndex])
     {
-      if (UTexture2D* tex = material->GetDiffuseTexture())
+      geo->getOrCreateStateSet()->setTextureAttributeAndModes(0, textures[section.TextureIndex].get());
+      if (section.Masked)
       {
-        osg::ref_ptr<osg::Image> img = new osg::Image;
-        tex->RenderTo(img.get());
-        osg::ref_ptr<osg::Texture2D> osgtex = new osg::Texture2D(img);
-        osgtex->setWrap(osg::Texture::WrapParameter::WRAP_S, osg::Texture::WrapMode::REPEAT);
-        osgtex->setWrap(osg::Texture::WrapParameter::WRAP_T, osg::Texture::WrapMode::REPEAT);
-        geo->getOrCreateStateSet()->setTextureAttributeAndModes(0, osgtex.get());
-        if (material->GetBlendMode() == EBlendMode::BLEND_Masked)
-        {
-          geo->getOrCreateStateSet()->setAttributeAndModes(new osg::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-          geo->getOrCreateStateSet()->setRenderingHint(osg::StateSet::TRANSPARENT_BIN);
-        }
+        geo->getOrCreateStateSet()->setAttributeAndModes(new osg::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        geo->getOrCreateStateSet()->setRenderingHint(osg::StateSet::TRANSPARENT_BIN);
       }
     }
     result->addDrawable(geo);
@@ -303,14 +277,13 @@ osg::Geode* LevelEditor::CreateStreamingLevelVolumeActor(ULevelStreamingVolume*
     return nullptr;
   }
 
-  osg::Geode* result = new osg::Geode;
+  SceneAssembler scene;
   for (ULevelStreaming* level : aliveLevels)
   {
-    osg::Geode* lgeode = new osg::Geode;
-    lgeode->setName(level->PackageName.UTF8().c_str());
-    result->addChild(lgeode);
-    CreateLevel(level->Level, lgeode);
+    scene.AddLevel(level->Level, level->PackageName);
   }
 
+  osg::Geode* result = new osg::Geode;
+  CreateScene(scene, result);
   return result;
 }
@@ -2,8 +2,10 @@
 #include "GenericEditor.h"
 
 #include <Tera/ULevel.h>
+#include <Utils/SceneAssembler.h>
 
 #include "../Misc/OSGWindow.h"
+#include <osg/Texture2D>
 
 #include <unordered_map>
 
@@ -29,9 +31,11 @@ public:
 protected:
   void CreateRenderer();
   void CreateLevel(ULevel* level, osg::Geode* root);
+  // Create OSG nodes for the assembled scene. Instances share geometry and textures of the same mesh
+  void CreateScene(const SceneAssembler& scene, osg::Geode* root);
   void OnIdle(wxIdleEvent& e);
 
-  osg::Geode* CreateStaticActor(UStaticMeshActor* actor, FVector& translation, FVector& scale3d, FRotator& rotation, float& scale);
+  osg::Geode* CreateMesh(const SceneMesh& mesh, const std::vector<osg::ref_ptr<osg::Texture2D>>& textures);
   osg::Geode* CreateStreamingLevelVolumeActor(ULevelStreamingVolume* actor);
 
 protected:
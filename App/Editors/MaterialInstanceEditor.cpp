@@ -24,7 +24,7 @@ MaterialInstanceEditor::MaterialInstanceEditor(wxPanel* parent, PackageWindow* w
 	bSizer2 = new wxBoxSizer(wxVERTICAL);
 
 	wxStaticText* m_staticText1;
-	m_staticText1 = new wxStaticText(m_panel1, wxID_ANY, wxT("Static Parameter Overrides:"), wxDefaultPosition, wxDefaultSize, 0);
+	m_staticText1 = new wxStaticText(m_panel1, wxID_ANY, wxT("Parameters:"), wxDefaultPosition, wxDefaultSize, 0);
 	m_staticText1->Wrap(-1);
 	bSizer2->Add(m_staticText1, 0, wxEXPAND | wxBOTTOM | wxRIGHT | wxLEFT, 5);
 
@@ -126,6 +126,27 @@ void MaterialInstanceEditor::OnObjectLoaded()
 					StaticParameterOverrides->AppendIn(cat, prop);
 				}
 			}
+
+			// Values merged down the parent chain
+			std::shared_ptr<const FMaterialParameterTable> table = mi->GetParameterTable();
+			cat = new wxPropertyCategory("Scalars", wxT("PScalars"));
+			StaticParameterOverrides->AppendIn(root, cat);
+			for (const auto& pair : table->Scalars)
+			{
+				wxFloatProperty* prop = new wxFloatProperty(pair.first.WString(), wxString::Format("%016llx", (uint64)std::addressof(pair)), pair.second);
+				prop->Enable(false);
+				StaticParameterOverrides->AppendIn(cat, prop);
+			}
+
+			cat = new wxPropertyCategory("Vectors", wxT("PVectors"));
+			StaticParameterOverrides->AppendIn(root, cat);
+			for (const auto& pair : table->Vectors)
+			{
+				const FLinearColor& c = pair.second;
+				wxStringProperty* prop = new wxStringProperty(pair.first.WString(), wxString::Format("%016llx", (uint64)std::addressof(pair)), wxString::Format("%.3f, %.3f, %.3f, %.3f", c.R, c.G, c.B, c.A));
+				prop->Enable(false);
+				StaticParameterOverrides->AppendIn(cat, prop);
+			}
 			
 			StaticParameterOverrides->Thaw();
 		}
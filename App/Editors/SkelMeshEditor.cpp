@@ -7,7 +7,10 @@
 #include <osg/BlendFunc>
 #include <osg/Depth>
 
+#include <wx/filename.h>
+
 #include <Utils/FbxUtils.h>
+#include <Utils/GlbUtils.h>
 
 #include <Tera/Cast.h>
 #include <Tera/UMaterial.h>
@@ -77,12 +80,23 @@ void SkelMeshEditor::OnExportMenuClicked(wxCommandEvent& e)
 {
   FbxExportContext ctx;
   ctx.ExportSkeleton = e.GetId() == ExportMode::ExportFull;
-  wxString path = wxSaveFileSelector("mesh", wxT("FBX file|*.fbx"), Object->GetObjectName().WString(), Window);
+  wxString path = wxSaveFileSelector("mesh", wxT("FBX file|*.fbx|GLB file|*.glb"), Object->GetObjectName().WString(), Window);
   if (path.empty())
   {
     return;
   }
   ctx.Path = path.ToStdWstring();
+  if (wxFileName(path).GetExt().Lower() == wxT("glb"))
+  {
+    GlbExportContext glbCtx;
+    glbCtx.Path = ctx.Path;
+    glbCtx.ExportSkeleton = ctx.ExportSkeleton;
+    if (!GlbUtils::ExportSkeletalMesh((USkeletalMesh*)Object, glbCtx))
+    {
+      wxMessageBox(glbCtx.Error, wxT("Error!"), wxICON_ERROR);
+    }
+    return;
+  }
   FbxUtils utils;
   if (!utils.ExportSkeletalMesh((USkeletalMesh*)Object, ctx))
   {
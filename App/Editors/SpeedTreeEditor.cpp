@@ -14,7 +14,7 @@ void SpeedTreeEditor::OnExportClicked(wxCommandEvent& e)
   mitem = menu.Append(ExportMode::ExportSptAndMaterials, wxT("Export SPT with embeded materials"));
   mitem->Enable(false);
 
-  void* sptData = nullptr;
+  const void* sptData = nullptr;
   FILE_OFFSET sptDataSize = 0;
   switch (GetPopupMenuSelectionFromUser(menu))
   {
@@ -39,7 +39,6 @@ void SpeedTreeEditor::OnExportClicked(wxCommandEvent& e)
   wxString path = wxSaveFileSelector("SpeedTree", ".spt", Object->GetObjectName().WString(), this);
   if (path.empty())
   {
-    free(sptData);
     return;
   }
 
@@ -47,10 +46,8 @@ void SpeedTreeEditor::OnExportClicked(wxCommandEvent& e)
   if (!s.IsGood())
   {
     wxMessageBox("Failed to create/open \"" + path + "\"", "Error!", wxICON_ERROR);
-    free(sptData);
     return;
   }
 
-  s.SerializeBytes(sptData, sptDataSize);
-  free(sptData);
+  s.SerializeBytes((void*)sptData, sptDataSize);
 }
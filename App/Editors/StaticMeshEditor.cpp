@@ -7,7 +7,10 @@
 #include <osg/BlendFunc>
 #include <osg/Depth>
 
+#include <wx/filename.h>
+
 #include <Utils/FbxUtils.h>
+#include <Utils/GlbUtils.h>
 
 #include <Tera/Cast.h>
 #include <Tera/UMaterial.h>
@@ -72,12 +75,23 @@ void StaticMeshEditor::OnExportClicked(wxCommandEvent&)
 {
   FbxExportContext ctx;
   ctx.ExportSkeleton = false;
-  wxString path = wxSaveFileSelector("mesh", wxT("FBX file|*.fbx"), Object->GetObjectName().WString(), Window);
+  wxString path = wxSaveFileSelector("mesh", wxT("FBX file|*.fbx|GLB file|*.glb"), Object->GetObjectName().WString(), Window);
   if (path.empty())
   {
     return;
   }
   ctx.Path = path.ToStdWstring();
+  if (wxFileName(path).GetExt().Lower() == wxT("glb"))
+  {
+    GlbExportContext glbCtx;
+    glbCtx.Path = ctx.Path;
+    glbCtx.ExportSkeleton = ctx.ExportSkeleton;
+    if (!GlbUtils::ExportStaticMesh(Mesh, glbCtx))
+    {
+      wxMessageBox(glbCtx.Error, wxT("Error!"), wxICON_ERROR);
+    }
+    return;
+  }
   FbxUtils utils;
   if (!utils.ExportStaticMesh(Mesh, ctx))
   {
@@ -5,6 +5,7 @@
 
 #include <Tera/Cast.h>
 #include <Tera/FPackage.h>
+#include <Tera/FObjectResource.h>
 #include <Tera/UTexture.h>
 #include <Tera/USoundNode.h>
 
@@ -80,11 +81,25 @@ bool BulkImportOperation::Execute(ProgressWindow& progress)
     return false;
   }
 
+  TextureFileCache.reset();
+  if (TextureFileCachePath.size())
+  {
+    TextureFileCache = std::make_unique<TextureFileCacheWriter>(TextureFileCachePath.ToStdWstring());
+    if (!TextureFileCache->IsGood())
+    {
+      AddError("General", TextureFileCache->GetError());
+      TextureFileCache.reset();
+    }
+  }
+
   SendEvent(&progress, UPDATE_MAX_PROGRESS, total);
   SendEvent(&progress, UPDATE_PROGRESS_DESC, wxString::Format(wxT("Executing %d operation(s)..."), total));
   std::this_thread::sleep_for(std::chrono::seconds(1));
   
   int idx = 0;
+  // Sounds are imported in one batch. Targets that use the same file share its data
+  std::vector<SoundImportTarget> soundTargets;
+  std::vector<FPackage*> soundPackages;
   for (const auto& operation : Actions)
   {
     if (!operation.IsValid())
@@ -102,10 +117,19 @@ bool BulkImportOperation::Execute(ProgressWindow& progress)
       SendEvent(&progress, UPDATE_PROGRESS, idx);
       SendEvent(&progress, UPDATE_PROGRESS_DESC, wxString("Processing: ") + item.Package->GetPackageName(true).WString());
 
+      // Object dumps may be older than the package. Prefer the entry's path over its index
+      PACKAGE_INDEX index = item.Index;
+      wxString path = item.ObjectPath;
+      path.Replace("\\", ".");
+      if (FObjectExport* exp = item.Package->FindExportByPath(path.ToStdWstring()))
+      {
+        index = exp->ObjectIndex;
+      }
+
       UObject* object = nullptr;
       try
       {
-        if ((object = item.Package->GetObject(item.Index)))
+        if ((object = item.Package->GetObject(index)))
         {
           object->Load();
         }
@@ -130,7 +154,17 @@ bool BulkImportOperation::Execute(ProgressWindow& progress)
         }
         else if (operation.ClassName == USoundNodeWave::StaticClassName())
         {
-          ImportSound(item.Package, Cast<USoundNodeWave>(object), operation.ImportPath);
+          if (USoundNodeWave* sound = Cast<USoundNodeWave>(object))
+          {
+            SoundImportTarget& target = soundTargets.emplace_back();
+            target.Wave = sound;
+            target.Source = operation.ImportPath.ToStdWstring();
+            soundPackages.push_back(item.Package);
+          }
+          else
+          {
+            AddError(item.Package->GetPackageName().WString(), "Object is not a sound node!");
+          }
         }
         else
         {
@@ -178,9 +212,20 @@ bool BulkImportOperation::Execute(ProgressWindow& progress)
     }
   }
 
+  if (soundTargets.size())
+  {
+    SendEvent(&progress, UPDATE_PROGRESS_DESC, wxString::Format(wxT("Importing %d sound(s)..."), (int)soundTargets.size()));
+    ImportSounds(soundPackages, soundTargets);
+  }
+
   PackageSaveContext ctx;
   ctx.EmbedObjectPath = true;
   ctx.DisableTextureCaching = true;
+  if (TextureFileCache)
+  {
+    // Mips written to the mod cache must stay there
+    ctx.KeepTextureFileCache = TextureFileCache->GetName().String();
+  }
   SendEvent(&progress, UPDATE_PROGRESS_DESC, wxString("Saving..."));
   for (std::shared_ptr<FPackage> pkg : packages)
   {
@@ -295,6 +340,7 @@ void BulkImportOperation::ImportTexture(FPackage* package, UTexture2D* texture,
   travaller.SetFormat(processorFormat);
   travaller.SetAddressX(texture->AddressX);
   travaller.SetAddressY(texture->AddressY);
+  travaller.SetTextureFileCache(TextureFileCache.get());
 
   const auto& mips = processor.GetOutputMips();
   for (const auto mip : mips)
@@ -308,50 +354,19 @@ void BulkImportOperation::ImportTexture(FPackage* package, UTexture2D* texture,
   }
 }
 
-void BulkImportOperation::ImportSound(FPackage* package, USoundNodeWave* sound, const wxString& source)
+void BulkImportOperation::ImportSounds(const std::vector<FPackage*>& packages, std::vector<SoundImportTarget>& targets)
 {
-  if (!sound)
+  if (SoundTravaller::ImportBatch(targets))
   {
-    AddError(package->GetPackageName().WString(), "Object is not a sound node!");
     return;
   }
-
-  SoundTravaller travaller;
-  try
+  for (size_t idx = 0; idx < targets.size(); ++idx)
   {
-    void* soundData = nullptr;
-    FILE_OFFSET size = 0;
-
-    std::ifstream s(source.ToStdWstring(), std::ios::in | std::ios::binary);
-    size_t tmpPos = s.tellg();
-    s.seekg(0, std::ios::end);
-    size = (FILE_OFFSET)s.tellg();
-    s.seekg(tmpPos);
-    if (size > 0)
+    if (targets[idx].Error.size())
     {
-      soundData = malloc(size);
-      s.read((char*)soundData, size);
-      travaller.SetData(soundData, size);
-    }
-    else
-    {
-      AddError(package->GetPackageName().WString(), wxString("File is empty: ") + source);
-      return;
+      AddError(packages[idx]->GetPackageName().WString(), wxString("Failed to import data: ") + targets[idx].Error);
     }
   }
-  catch (const std::exception& e)
-  {
-    AddError(package->GetPackageName().WString(), e.what());
-  }
-  catch (...)
-  {
-    AddError(package->GetPackageName().WString(), "Unknown error!");
-  }
-
-  if (!travaller.Visit(sound))
-  {
-    AddError(package->GetPackageName().WString(), "Failed to import data!");
-  }
 }
 
 void BulkImportOperation::ImportUntyped(FPackage* package, UObject* tobject, const wxString& source)
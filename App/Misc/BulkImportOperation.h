@@ -5,6 +5,7 @@
 #include "../Windows/ProgressWindow.h"
 
 #include <Tera/Core.h>
+#include <Utils/TextureFileCacheWriter.h>
 
 struct BulkImportAction {
 	struct Entry {
@@ -70,6 +71,12 @@ public:
 
 	bool Execute(ProgressWindow& progress);
 
+	// Write imported texture mips to a texture file cache instead of packages
+	inline void SetTextureFileCachePath(const wxString& path)
+	{
+		TextureFileCachePath = path;
+	}
+
 	inline std::vector<std::pair<wxString, wxString>> GetErrors() const
 	{
 		return Errors;
@@ -83,11 +90,13 @@ public:
 protected:
 	void AddError(const wxString& source, const wxString& error);
 	void ImportTexture(FPackage* package, class UTexture2D* tobject, const wxString& source);
-	void ImportSound(FPackage* package, class USoundNodeWave* tobject, const wxString& source);
+	void ImportSounds(const std::vector<FPackage*>& packages, std::vector<struct SoundImportTarget>& targets);
 	void ImportUntyped(FPackage* package, class UObject* tobject, const wxString& source);
 
 protected:
 	wxString Path;
+	wxString TextureFileCachePath;
+	std::unique_ptr<TextureFileCacheWriter> TextureFileCache;
 	std::vector<BulkImportAction> Actions;
 	std::vector<std::pair<wxString, wxString>> Errors;
 };
\ No newline at end of file
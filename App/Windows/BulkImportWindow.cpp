@@ -1080,6 +1080,19 @@ void BulkImportWindow::OnContinueClicked(wxCommandEvent& event)
 		return;
 	}
 	BulkImportOperation operation(Actions, dlg.GetPath());
+	bool hasTextures = false;
+	for (const BulkImportAction& action : Actions)
+	{
+		if (action.ImportPath.size() && action.ClassName == UTexture2D::StaticClassName())
+		{
+			hasTextures = true;
+			break;
+		}
+	}
+	if (hasTextures && wxMessageBox(wxT("Store imported textures in a separate texture file cache?\nPackages will be smaller and load faster, but ModTextures.tfc must be installed along with them."), wxT("Texture file cache"), wxYES_NO | wxICON_QUESTION, this) == wxYES)
+	{
+		operation.SetTextureFileCachePath((std::filesystem::path(dlg.GetPath().ToStdWstring()) / "ModTextures.tfc").wstring());
+	}
 	ProgressWindow progress(this, wxT("Please wait..."));
 	progress.SetCanCancel(false);
 	progress.SetCurrentProgress(-1);
@@ -14,9 +14,12 @@
 #include <Utils/TextureTravaller.h>
 #include <Utils/TextureProcessor.h>
 #include <Utils/SoundTravaller.h>
+#include <Utils/GlbUtils.h>
 #include <Tera/FPackage.h>
 #include <Tera/UClass.h>
 #include <Tera/USoundNode.h>
+#include <Tera/UStaticMesh.h>
+#include <Tera/USkeletalMesh.h>
 #include <Tera/Cast.h>
 
 enum ObjTreeMenuId {
@@ -386,6 +389,10 @@ void CompositeExtractWindow::OnExtractClicked(wxCommandEvent& event)
 	{
     ExtractSounds();
 	}
+  else if (className == UStaticMesh::StaticClassName() || className == USkeletalMesh::StaticClassName())
+  {
+    ExtractMeshes();
+  }
   else
   {
     ExtractUntyped();
@@ -764,6 +771,136 @@ void CompositeExtractWindow::ExtractSounds()
   }
 }
 
+void CompositeExtractWindow::ExtractMeshes()
+{
+  int resultCount = GetEnabledResultsCount();
+  if (!resultCount)
+  {
+    wxMessageBox(_("There are no packages selected.\nPlease select packages you want to extract!"), _("Nothing to extract!"), wxICON_INFORMATION);
+    return;
+  }
+
+  wxDirDialog dlg(NULL, "Select a directory to export meshes to...", "", wxDD_DEFAULT_STYLE | wxDD_DIR_MUST_EXIST);
+  if (dlg.ShowModal() != wxID_OK || dlg.GetPath().empty())
+  {
+    return;
+  }
+  const std::filesystem::path destDir = dlg.GetPath().ToStdWstring();
+
+  auto searchResult = GetSearchResult();
+
+  ProgressWindow progress(this, wxT("Exporting meshes..."));
+  progress.SetActionText(wxT("Preparing..."));
+  progress.SetCanCancel(true);
+  progress.SetMaxProgress(resultCount);
+  progress.SetCurrentProgress(0);
+
+  // Meshes are written by GlbUtils::ExportMeshes in batches. A batch keeps its packages open until it is exported
+  const size_t batchSize = 64;
+
+  bool canceled = false;
+  std::vector<std::pair<std::string, std::string>> failed;
+  std::thread([&] {
+    std::vector<std::shared_ptr<FPackage>> packages;
+    std::vector<UObject*> meshes;
+    std::vector<GlbExportContext> contexts;
+    std::vector<std::string> names;
+    auto exportBatch = [&](bool write) {
+      if (write && meshes.size())
+      {
+        SendEvent(&progress, UPDATE_PROGRESS_DESC, wxString::Format("Writing %d meshes...", (int)meshes.size()));
+        if (!GlbUtils::ExportMeshes(meshes, contexts))
+        {
+          for (size_t idx = 0; idx < contexts.size(); ++idx)
+          {
+            if (contexts[idx].Error.size())
+            {
+              failed.emplace_back(std::make_pair(names[idx], contexts[idx].Error));
+            }
+          }
+        }
+      }
+      for (std::shared_ptr<FPackage>& pkg : packages)
+      {
+        FPackage::UnloadPackage(pkg);
+      }
+      packages.clear();
+      meshes.clear();
+      contexts.clear();
+      names.clear();
+    };
+
+    for (size_t idx = 0; idx < searchResult.size(); ++idx)
+    {
+      if (progress.IsCanceled())
+      {
+        exportBatch(false);
+        SendEvent(&progress, UPDATE_PROGRESS_FINISH);
+        canceled = true;
+        return;
+      }
+      if (!searchResult[idx].Enabled)
+      {
+        continue;
+      }
+      wxString desc = "Reading " + searchResult[idx].PackageName + ".gpk";
+      SendEvent(&progress, UPDATE_PROGRESS_DESC, desc);
+      SendEvent(&progress, UPDATE_PROGRESS, (int)idx);
+      std::shared_ptr<FPackage> pkg = nullptr;
+      try
+      {
+        if ((pkg = FPackage::GetPackageNamed(searchResult[idx].PackageName.ToStdWstring())))
+        {
+          pkg->Load();
+          UObject* obj = pkg->GetObject(searchResult[idx].ObjectIndex);
+          if (!obj || (!obj->IsA<UStaticMesh>() && !obj->IsA<USkeletalMesh>()))
+          {
+            UThrow("Failed to load the object!");
+          }
+          GlbExportContext& ctx = contexts.emplace_back();
+          ctx.Path = (destDir / (searchResult[idx].PackageName.ToStdWstring() + L"_" + obj->GetObjectName().WString() + L".glb")).wstring();
+          meshes.push_back(obj);
+          names.push_back(searchResult[idx].PackageName.ToStdString());
+          packages.push_back(pkg);
+          if (meshes.size() >= batchSize)
+          {
+            exportBatch(true);
+          }
+        }
+        else
+        {
+          UThrow("Failed to open a package!");
+        }
+      }
+      catch (const std::exception& e)
+      {
+        failed.emplace_back(std::make_pair(searchResult[idx].PackageName, e.what()));
+        FPackage::UnloadPackage(pkg);
+      }
+    }
+    exportBatch(true);
+    SendEvent(&progress, UPDATE_PROGRESS_FINISH);
+  }).detach();
+
+  progress.ShowModal();
+  if (!canceled)
+  {
+    if (failed.size())
+    {
+      std::ofstream s(destDir / "error_log.txt", std::ios::out | std::ios::binary);
+      for (const auto& pair : failed)
+      {
+        s << pair.first << ": " << pair.second << '\n';
+      }
+      wxMessageBox(_("Failed to export some of the meshes.\nSee error_log.txt in the output folder for more details."), _("Warning!"), wxICON_WARNING);
+    }
+    else
+    {
+      wxMessageBox(_("Meshes were exported successfuly!"), _("Done!"), wxICON_INFORMATION);
+    }
+  }
+}
+
 void CompositeExtractWindow::ExtractUntyped()
 {
   int resultCount = GetEnabledResultsCount();
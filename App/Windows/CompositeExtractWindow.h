@@ -24,6 +24,7 @@ protected:
 
 	void ExtractTextures();
 	void ExtractSounds();
+	void ExtractMeshes();
 	void ExtractUntyped();
 
 	int GetResultsCount();
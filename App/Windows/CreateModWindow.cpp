@@ -40,6 +40,10 @@ CreateModWindow::CreateModWindow(wxWindow* parent, wxWindowID id, const wxString
 	wxBoxSizer* bSizer3;
 	bSizer3 = new wxBoxSizer(wxHORIZONTAL);
 
+	CompressCheckbox = new wxCheckBox(this, wxID_ANY, wxT("Compress packages"), wxDefaultPosition, wxDefaultSize, 0);
+	CompressCheckbox->SetToolTip(wxT("Compress packages that are not compressed yet. Makes the mod smaller."));
+	bSizer3->Add(CompressCheckbox, 0, wxALL | wxALIGN_CENTER_VERTICAL, 5);
+
 	wxPanel* m_panel1;
 	m_panel1 = new wxPanel(this, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxTAB_TRAVERSAL);
 	bSizer3->Add(m_panel1, 1, wxEXPAND | wxALL, 5);
@@ -71,6 +75,11 @@ wxString CreateModWindow::GetAuthor() const
 	return AuthorField->GetValue();
 }
 
+bool CreateModWindow::GetCompress() const
+{
+	return CompressCheckbox->GetValue();
+}
+
 void CreateModWindow::OnTextEvent(wxCommandEvent&)
 {
 	bool ok = false;
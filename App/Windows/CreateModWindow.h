@@ -8,6 +8,7 @@ public:
 
 	wxString GetName() const;
 	wxString GetAuthor() const;
+	bool GetCompress() const;
 
 protected:
 	void OnTextEvent(wxCommandEvent&);
@@ -15,6 +16,7 @@ protected:
 protected:
 	wxTextCtrl* NameField = nullptr;
 	wxTextCtrl* AuthorField = nullptr;
+	wxCheckBox* CompressCheckbox = nullptr;
 	wxButton* CreateButton = nullptr;
 	wxButton* CancelButton = nullptr;
 
@@ -28,6 +28,8 @@
 #include <Tera/UClass.h>
 #include <Tera/ULevel.h>
 
+#include <Utils/ObjectLoader.h>
+
 enum ControlElementId {
 	New = wxID_HIGHEST + 1,
 	CreateMod,
@@ -66,6 +68,8 @@ wxDEFINE_EVENT(SELECT_OBJECT, wxCommandEvent);
 wxDEFINE_EVENT(UPDATE_PROPERTIES, wxCommandEvent);
 
 const wxString HelpUrl = wxS("https://github.com/VenoMKO/RealEditor/wiki");
+// Number of siblings on each side of the selection to load in the background
+const int32 PrefetchNeighbourCount = 2;
 
 #include "PackageWindowLayout.h"
 
@@ -153,6 +157,10 @@ void PackageWindow::OnCloseWindow(wxCloseEvent& event)
 
 PackageWindow::~PackageWindow()
 {
+	for (const auto& request : Prefetches)
+	{
+		request->Cancel();
+	}
 	FPackage::UnloadPackage(Package);
 	delete ImageList;
 }
@@ -164,58 +172,23 @@ wxString PackageWindow::GetPackagePath() const
 
 void PackageWindow::SelectObject(const wxString& objectPath)
 {
-  std::vector<std::string> components;
-  std::istringstream f(objectPath.ToStdString());
-  std::string tmp;
-  while (std::getline(f, tmp, '.'))
-	{
-		if (tmp.size())
-		{
-			components.push_back(tmp);
-		}
-  }
-	if (components.empty())
+	// The first component is the package name
+	const size_t pos = objectPath.find('.');
+	if (pos == wxString::npos || pos + 1 >= objectPath.size())
 	{
 		return;
 	}
+	// Select the closest outer if the object no longer exists
+	FString path = objectPath.substr(pos + 1).ToStdWstring();
 	FObjectResource* found = nullptr;
-
-	std::vector<FObjectExport*> searchItems = Package->GetRootExports();
-	for (int32 idx = 1; idx < components.size(); ++idx)
+	while (!(found = Package->FindExportByPath(path)) && !(found = Package->FindImportByPath(path)))
 	{
-		std::string upper = components[idx];
-    std::transform(upper.begin(), upper.end(), upper.begin(),
-      [](unsigned char c) { return std::toupper(c); }
-    );
-		for (FObjectExport* exp : searchItems)
+		const size_t end = path.FindLastOf('.');
+		if (end == std::string::npos)
 		{
-			if (exp->GetObjectName().ToUpper() == upper)
-			{
-				found = exp;
-				searchItems = exp->Inner;
-				break;
-			}
+			break;
 		}
-	}
-	if (!found)
-	{
-		std::vector<FObjectImport*> searchItems = Package->GetRootImports();
-    for (int32 idx = 1; idx < components.size(); ++idx)
-    {
-      std::string upper = components[idx];
-      std::transform(upper.begin(), upper.end(), upper.begin(),
-        [](unsigned char c) { return std::toupper(c); }
-      );
-      for (FObjectImport* imp : searchItems)
-      {
-        if (imp->GetObjectName().ToUpper() == upper)
-        {
-          found = imp;
-          searchItems = imp->Inner;
-          break;
-        }
-      }
-    }
+		path = path.Substr(0, end);
 	}
 	if (found && found->ObjectIndex)
 	{
@@ -275,6 +248,25 @@ bool PackageWindow::OnObjectLoaded(const std::string& id)
 	return false;
 }
 
+bool PackageWindow::OnObjectLoadFailed(const std::string& id)
+{
+	auto editors = Editors;
+	auto active = ActiveEditor;
+	for (const auto p : editors)
+	{
+		if (p.second->GetEditorId() == id)
+		{
+			p.second->OnObjectLoadFailed();
+			if (active == p.second)
+			{
+				wxMessageBox(wxString::Format("Failed to load %s! See the log for details.", active->GetObject()->GetObjectName().WString()), "Error!", wxICON_ERROR, this);
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
 void PackageWindow::OnUpdateProperties(wxCommandEvent&)
 {
 	if (ActiveEditor)
@@ -460,6 +452,38 @@ void PackageWindow::OnExportObjectSelected(INT index)
 			editor->LoadObject();
 		}
 	}
+	PrefetchNeighbours(fobj);
+}
+
+void PackageWindow::PrefetchNeighbours(FObjectExport* exp)
+{
+	for (const auto& request : Prefetches)
+	{
+		request->Cancel();
+	}
+	Prefetches.clear();
+
+	const std::vector<FObjectExport*>& siblings = exp->Outer ? exp->Outer->Inner : Package->GetRootExports();
+	auto it = std::find(siblings.begin(), siblings.end(), exp);
+	if (it == siblings.end())
+	{
+		return;
+	}
+	const int32 pos = (int32)(it - siblings.begin());
+	const int32 first = std::max(pos - PrefetchNeighbourCount, 0);
+	const int32 last = std::min(pos + PrefetchNeighbourCount, (int32)siblings.size() - 1);
+	for (int32 idx = first; idx <= last; ++idx)
+	{
+		if (idx == pos)
+		{
+			continue;
+		}
+		UObject* object = Package->GetObject(siblings[idx]->ObjectIndex, false);
+		if (object && !object->IsLoaded())
+		{
+			Prefetches.push_back(ObjectLoader::Get().Load(Package, object, LoadPriority::Prefetch));
+		}
+	}
 }
 
 void PackageWindow::UpdateProperties(UObject* object, std::vector<FPropertyTag*> properties)
@@ -581,7 +605,11 @@ void PackageWindow::OnCreateModClicked(wxCommandEvent&)
 
 	try
 	{
-		FPackage::CreateCompositeMod(paths, dest.ToStdWstring(), modInfo.GetName().ToStdString(), modInfo.GetAuthor().ToStdString());
+		std::vector<FCompositeModEntry> entries = FPackage::CreateCompositeMod(paths, dest.ToStdWstring(), modInfo.GetName().ToStdString(), modInfo.GetAuthor().ToStdString(), modInfo.GetCompress());
+		for (const FCompositeModEntry& entry : entries)
+		{
+			LogI("%s: %s at 0x%08X, 0x%08X bytes, hash %016llX", entry.Path.Filename().C_str(), entry.ObjectPath.C_str(), entry.Offset, entry.Size, entry.Hash);
+		}
 	}
 	catch (const std::exception& e)
 	{
@@ -660,7 +688,15 @@ void PackageWindow::OnSaveAsClicked(wxCommandEvent& e)
 
 	FPackage* package = Package.get();
 	std::thread([&progress, &context, package] {
-		bool result = package->Save(context);
+		bool result = false;
+		try
+		{
+			result = package->Save(context);
+		}
+		catch (const std::exception& e)
+		{
+			context.Error = e.what();
+		}
 		SendEvent(&progress, UPDATE_PROGRESS_FINISH, result);
 	}).detach();
 
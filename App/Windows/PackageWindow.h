@@ -18,6 +18,7 @@ wxDECLARE_EVENT(UPDATE_PROPERTIES, wxCommandEvent);
 class App;
 class ArchiveInfoView;
 class FPackage;
+class FObjectExport;
 class UObject;
 
 class PackageWindow : public wxFrame {
@@ -34,6 +35,7 @@ public:
 	void SelectObject(UObject* object);
 
 	bool OnObjectLoaded(const std::string& id);
+	bool OnObjectLoadFailed(const std::string& id);
 	void OnUpdateProperties(wxCommandEvent&);
 	void FixOSG();
 
@@ -78,6 +80,8 @@ private:
 	void OnImportObjectSelected(INT index);
 	void OnExportObjectSelected(INT index);
 	void OnNoneObjectSelected();
+	// Queue loading of the objects next to the export, so browsing the tree doesn't wait for each of them
+	void PrefetchNeighbours(FObjectExport* exp);
 
 	void SetPropertiesHidden(bool hidden);
 	void SetContentHidden(bool hidden);
@@ -125,6 +129,7 @@ private:
 
 	std::map<PACKAGE_INDEX, GenericEditor*> Editors;
 	GenericEditor* ActiveEditor = nullptr;
+	std::vector<std::shared_ptr<ObjectLoadRequest>> Prefetches;
 	wxTimer HeartBeat;
 
 	wxObjectDataPtr<ObjectTreeModel> DataModel;
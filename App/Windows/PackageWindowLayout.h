@@ -429,6 +429,8 @@ void PackageWindow::ShowEditor(GenericEditor* editor)
 	if (ActiveEditor && ActiveEditor != editor)
 	{
 		Toolbar->Unbind(wxEVT_TOOL, &GenericEditor::OnToolBarEvent, ActiveEditor);
+		// The user moved on. Don't waste workers on the previous object
+		ActiveEditor->CancelLoading();
 	}
 	bool shown = false;
 	for (std::pair<const INT, GenericEditor*>& item : Editors)
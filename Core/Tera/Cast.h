@@ -3,7 +3,7 @@
 template<typename T>
 T* Cast(UObject* obj)
 {
-  return obj && obj->IsA(T::StaticClassName()) ? (T*)obj : nullptr;
+  return obj && obj->IsA<T>() ? (T*)obj : nullptr;
 }
 
 template< class T >
@@ -16,7 +16,7 @@ template< class T, class U >
 T* CastChecked(U* obj)
 {
 #if _DEBUG
-	if (!obj || !obj->IsA(T::StaticClassName()))
+	if (!obj || !obj->template IsA<T>())
 	{
 		LogE("Cast of %s to %s failed", obj ? obj->GetObjectName().UTF8().c_str() : "NULL", T::StaticClassName());
 	}
@@ -8,6 +8,7 @@
 #include <array>
 #include <bitset>
 #include <cstring>
+#include <emmintrin.h>
 #define NOGDICAPMASKS
 #define NOMENUS
 #define NOATOM
@@ -42,7 +43,8 @@
 #include "ALog.h"
 
 #define HEAP_ALLOC(var,size) lzo_align_t __LZO_MMODEL var [ ((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t) ]
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+// Per-thread work memory. Packages are compressed in parallel.
+static thread_local HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
 
 #define COMPRESSED_BLOCK_MAGIC PACKAGE_MAGIC
 #define COMPRESSION_FLAGS_TYPE_MASK		0x0F
@@ -101,6 +103,71 @@ std::wstring A2W(const std::string& str)
   return A2W(&str[0], (int32)str.length());
 }
 
+void UTF16ToUTF8(const wchar* str, size_t len, std::string& output)
+{
+  size_t pos = output.size();
+  // Worst case is 3 bytes per UTF16 unit. Surrogate pairs take 4 bytes per 2 units.
+  output.resize(pos + len * 3);
+  char* dst = &output[0];
+  size_t idx = 0;
+  const __m128i nonAsciiMask = _mm_set1_epi16((short)0xFF80);
+  const __m128i zero = _mm_setzero_si128();
+  while (idx < len)
+  {
+    // Convert 8 ASCII characters at a time
+    while (idx + 8 <= len)
+    {
+      __m128i chars = _mm_loadu_si128((const __m128i*)(str + idx));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chars, nonAsciiMask), zero)) != 0xFFFF)
+      {
+        break;
+      }
+      _mm_storel_epi64((__m128i*)(dst + pos), _mm_packus_epi16(chars, chars));
+      pos += 8;
+      idx += 8;
+    }
+    if (idx >= len)
+    {
+      break;
+    }
+
+    uint32 ch = (uint16)str[idx++];
+    if (ch >= 0xD800 && ch <= 0xDBFF && idx < len && (uint16)str[idx] >= 0xDC00 && (uint16)str[idx] <= 0xDFFF)
+    {
+      ch = 0x10000 + ((ch - 0xD800) << 10) + ((uint16)str[idx++] - 0xDC00);
+    }
+    else if (ch >= 0xD800 && ch <= 0xDFFF)
+    {
+      // Unpaired surrogate. Same replacement character WideCharToMultiByte uses
+      ch = 0xFFFD;
+    }
+
+    if (ch < 0x80)
+    {
+      dst[pos++] = (char)ch;
+    }
+    else if (ch < 0x800)
+    {
+      dst[pos++] = (char)(0xC0 | (ch >> 6));
+      dst[pos++] = (char)(0x80 | (ch & 0x3F));
+    }
+    else if (ch < 0x10000)
+    {
+      dst[pos++] = (char)(0xE0 | (ch >> 12));
+      dst[pos++] = (char)(0x80 | ((ch >> 6) & 0x3F));
+      dst[pos++] = (char)(0x80 | (ch & 0x3F));
+    }
+    else
+    {
+      dst[pos++] = (char)(0xF0 | (ch >> 18));
+      dst[pos++] = (char)(0x80 | ((ch >> 12) & 0x3F));
+      dst[pos++] = (char)(0x80 | ((ch >> 6) & 0x3F));
+      dst[pos++] = (char)(0x80 | (ch & 0x3F));
+    }
+  }
+  output.resize(pos);
+}
+
 uint64 GetFileTime(const std::wstring& path)
 {
   struct _stat64 fileInfo;
@@ -111,6 +178,17 @@ uint64 GetFileTime(const std::wstring& path)
   return 0;
 }
 
+uint64 HashBuffer(const void* data, size_t size)
+{
+  const uint8* bytes = (const uint8*)data;
+  uint64 hash = 0xcbf29ce484222325ull;
+  for (size_t idx = 0; idx < size; ++idx)
+  {
+    hash = (hash ^ bytes[idx]) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
 #include <wx/string.h>
 
 void UThrow(const char* fmt, ...)
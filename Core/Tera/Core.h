@@ -24,6 +24,9 @@ static const float APP_VER = 1.53f;
 // Packed positions are allowed on consoles only.
 #define ENABLE_PACKED_VERTEX_POSITION 0
 
+// Size of the reusable buffer FPackage::Save uses to copy unchanged data
+#define SAVE_COPY_BUFFER_SIZE (1024 * 1024 * 4)
+
 #if _DEBUG
 // DUMP_PATH should be set in the ENV
 #if defined(DUMP_PATH)
@@ -174,8 +177,12 @@ std::string W2A(const std::wstring& str);
 // UTF8 string to wide
 std::wstring A2W(const char* str, int32 len = -1);
 std::wstring A2W(const std::string& str);
+// UTF16 to UTF8 without the Win32 round trip. Appends len characters to the output. ASCII runs are converted with SSE2
+void UTF16ToUTF8(const wchar* str, size_t len, std::string& output);
 // Get file's last modification date
 uint64 GetFileTime(const std::wstring& path);
+// FNV-1a hash of a memory block
+uint64 HashBuffer(const void* data, size_t size);
 
 // Format like a C string
 std::string Sprintf(const char* fmt, ...);
@@ -359,4 +359,12 @@ enum AnimationCompressionFormat
   ACF_Float32NoW = 5,
   ACF_Identity = 6,
   ACF_MAX = 7,
+};
+
+enum AnimationKeyFormat
+{
+  AKF_ConstantKeyLerp = 0,
+  AKF_VariableKeyLerp = 1,
+  AKF_PerTrackCompression = 2,
+  AKF_MAX = 3,
 };
\ No newline at end of file
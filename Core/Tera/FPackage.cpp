@@ -16,6 +16,8 @@
 #include <algorithm>
 #include <filesystem>
 #include <array>
+#include <future>
+#include <charconv>
 #include <ppl.h>
 
 const char* PackageMapperName = "PkgMapper";
@@ -35,21 +37,113 @@ std::vector<std::shared_ptr<FPackage>> FPackage::LoadedPackages;
 std::vector<std::shared_ptr<FPackage>> FPackage::DefaultClassPackages;
 std::vector<FString> FPackage::DirCache;
 std::unordered_map<FString, FString> FPackage::TfcCache;
-std::unordered_map<FString, FString> FPackage::PkgMap;
+FStringMap<FString> FPackage::PkgMap;
 std::unordered_map<FString, FString> FPackage::ObjectRedirectorMap;
-std::unordered_map<FString, FCompositePackageMapEntry> FPackage::CompositPackageMap;
-std::unordered_map<FString, std::vector<FString>> FPackage::CompositPackageList;
-std::unordered_map<FString, FBulkDataInfo> FPackage::BulkDataMap;
-std::unordered_map<FString, FTextureFileCacheInfo> FPackage::TextureCacheMap;
+FStringMap<FCompositePackageMapEntry> FPackage::CompositPackageMap;
+FStringMap<std::vector<FString>> FPackage::CompositPackageList;
+FStringMap<FBulkDataInfo> FPackage::BulkDataMap;
+FStringMap<FTextureFileCacheInfo> FPackage::TextureCacheMap;
 std::unordered_map<FString, std::unordered_map<FString, AMetaDataEntry>> FPackage::MetaData;
 std::mutex FPackage::ClassMapMutex;
-std::unordered_map<FString, UObject*> FPackage::ClassMap;
+FStringMap<UObject*> FPackage::ClassMap;
 std::unordered_set<FString> FPackage::MissingClasses;
 std::mutex FPackage::MissingPackagesMutex;
 std::vector<FString> FPackage::MissingPackages;
+std::mutex FPackage::ResolvedImportsMutex;
+FStringMap<FPackage::FResolvedImport> FPackage::ResolvedImports;
+std::unordered_map<FPackage*, std::vector<FString>> FPackage::ResolvedImportKeys;
 
 uint16 FPackage::CoreVersion = 0;
 
+// Composite containers are opened once and their handles are reused by all composite package reads
+std::mutex CompositeContainersMutex;
+FStringMap<FString> CompositeContainerPaths;
+FStringMap<std::vector<std::unique_ptr<FReadStream>>> CompositeContainerStreams;
+// Idle handles kept per container
+const size_t MaxIdleContainerStreams = 4;
+
+// Exports closer than this are read together with the gap between them
+const FILE_OFFSET ReadAheadMaxGap = 64 * 1024;
+// Size limits of a single read when loading many exports
+const FILE_OFFSET ReadAheadMinRangeSize = 1024 * 1024;
+const FILE_OFFSET ReadAheadMaxRangeSize = 16 * 1024 * 1024;
+// Source size limit of a batch of packages prepared for a composite mod
+const uint64 CompositeModBatchSize = 256 * 1024 * 1024;
+
+void ResetCompositeContainers()
+{
+  std::scoped_lock<std::mutex> lock(CompositeContainersMutex);
+  CompositeContainerPaths.clear();
+  CompositeContainerStreams.clear();
+}
+
+// Find a container file by name. Falls back to a prefix search for names with no exact match
+FString FindCompositeContainer(const FString& fileName, const FString& rootDir, const std::vector<FString>& dirCache)
+{
+  std::scoped_lock<std::mutex> lock(CompositeContainersMutex);
+  if (CompositeContainerPaths.empty())
+  {
+    for (const FString& path : dirCache)
+    {
+      std::wstring filename = path.FilenameWString();
+      filename = filename.substr(0, filename.find(L'.'));
+      CompositeContainerPaths.emplace(FString(filename), path);
+    }
+  }
+  auto it = CompositeContainerPaths.find(fileName);
+  if (it != CompositeContainerPaths.end())
+  {
+    return rootDir.FStringByAppendingPath(it->second);
+  }
+  const std::wstring tmp = fileName.WString();
+  for (const FString& path : dirCache)
+  {
+    std::wstring filename = path.FilenameWString();
+    if (filename.size() < tmp.size())
+    {
+      continue;
+    }
+    if (std::mismatch(tmp.begin(), tmp.end(), filename.begin()).first == tmp.end())
+    {
+      CompositeContainerPaths[fileName] = path;
+      return rootDir.FStringByAppendingPath(path);
+    }
+  }
+  return FString();
+}
+
+// Read a package slice from a container using a pooled handle
+bool ReadCompositeSlice(const FString& containerPath, FILE_OFFSET offset, FILE_OFFSET size, void* dst)
+{
+  std::unique_ptr<FReadStream> stream;
+  {
+    std::scoped_lock<std::mutex> lock(CompositeContainersMutex);
+    auto& pool = CompositeContainerStreams[containerPath];
+    if (pool.size())
+    {
+      stream = std::move(pool.back());
+      pool.pop_back();
+    }
+  }
+  if (!stream)
+  {
+    stream = std::make_unique<FReadStream>(containerPath);
+  }
+  stream->SetPosition(offset);
+  stream->SerializeBytes(dst, size);
+  if (!stream->IsGood())
+  {
+    return false;
+  }
+  std::scoped_lock<std::mutex> lock(CompositeContainersMutex);
+  auto& pool = CompositeContainerStreams[containerPath];
+  if (pool.size() < MaxIdleContainerStreams)
+  {
+    pool.emplace_back(std::move(stream));
+  }
+  return true;
+}
+
 void BuildPackageList(const FString& path, std::vector<FString>& dirCache, std::unordered_map<FString, FString>& tfcCache)
 {
   std::filesystem::path fspath(path.WString());
@@ -137,30 +231,35 @@ void EncryptMapper(const FString& decrypted, std::vector<char>& encrypted)
   }
 }
 
-void DecryptMapper(const std::filesystem::path& path, FString& decrypted)
+void ReadMapper(const std::filesystem::path& path, std::vector<char>& encrypted)
 {
   if (!std::filesystem::exists(path))
   {
     UThrow("File \"%s\" does not exist!", path.string().c_str());
   }
-  std::vector<char> encrypted;
-  size_t size = 0;
-
+  std::ifstream s(path.wstring(), std::ios::binary | std::ios::ate);
+  if (!s.is_open())
+  {
+    UThrow("Can't open \"%s\"!", path.string().c_str());
+  }
+  s.seekg(0, std::ios_base::end);
+  size_t size = s.tellg();
+  s.seekg(0, std::ios_base::beg);
+  encrypted.resize(size);
+  if (size)
   {
-    std::ifstream s(path.wstring(), std::ios::binary | std::ios::ate);
-    if (!s.is_open())
-    {
-      UThrow("Can't open \"%s\"!", path.string().c_str());
-    }
-    s.seekg(0, std::ios_base::end);
-    size = s.tellg();
-    s.seekg(0, std::ios_base::beg);
-    encrypted.resize(size);
-    decrypted.Resize(size);
     s.read(&encrypted[0], size);
   }
-  
-  LogI("Decrypting \"%s\"", path.filename().string().c_str());
+}
+
+void DecryptMapper(const std::vector<char>& encrypted, FString& decrypted)
+{
+  const size_t size = encrypted.size();
+  decrypted.Resize(size);
+  if (!size)
+  {
+    return;
+  }
 
   size_t offset = 0;
   for (; offset + sizeof(Key1) <= size; offset += sizeof(Key1))
@@ -196,9 +295,18 @@ void DecryptMapper(const std::filesystem::path& path, FString& decrypted)
   }
 }
 
+void DecryptMapper(const std::filesystem::path& path, FString& decrypted)
+{
+  std::vector<char> encrypted;
+  ReadMapper(path, encrypted);
+  LogI("Decrypting \"%s\"", path.filename().string().c_str());
+  DecryptMapper(encrypted, decrypted);
+}
+
 void FPackage::SetRootPath(const FString& path)
 {
   RootDir = path;
+  ResetCompositeContainers();
 #if CACHE_S1GAME_CONTENTS
   std::filesystem::path listPath = std::filesystem::path(path.WString()) / PackageListName;
   FReadStream s(listPath.wstring());
@@ -221,11 +329,8 @@ void FPackage::SetMetaData(const std::unordered_map<FString, std::unordered_map<
 
 FBulkDataInfo* FPackage::GetBulkDataInfo(const FString& bulkDataName)
 {
-  if (BulkDataMap.count(bulkDataName))
-  {
-    return &BulkDataMap[bulkDataName];
-  }
-  return nullptr;
+  auto it = BulkDataMap.find(bulkDataName);
+  return it == BulkDataMap.end() ? nullptr : &it->second;
 }
 
 FString FPackage::GetTextureFileCachePath(const FString& tfcName)
@@ -237,12 +342,12 @@ FString FPackage::GetTextureFileCachePath(const FString& tfcName)
   return FString();
 }
 
-const std::unordered_map<FString, FCompositePackageMapEntry>& FPackage::GetCompositePackageMap()
+const FStringMap<FCompositePackageMapEntry>& FPackage::GetCompositePackageMap()
 {
   return CompositPackageMap;
 }
 
-const std::unordered_map<FString, std::vector<FString>>& FPackage::GetCompositePackageList()
+const FStringMap<std::vector<FString>>& FPackage::GetCompositePackageList()
 {
   return CompositPackageList;
 }
@@ -256,11 +361,8 @@ FString FPackage::GetCompositePackageMapPath()
 
 FString FPackage::GetObjectCompositePath(const FString& path)
 {
-  if (path.Size() && PkgMap.count(path.ToUpper()))
-  {
-    return PkgMap.at(path.ToUpper());
-  }
-  return FString();
+  auto it = path.Size() ? PkgMap.find(path) : PkgMap.end();
+  return it == PkgMap.end() ? FString() : it->second;
 }
 
 void FPackage::UpdateDirCache()
@@ -272,50 +374,161 @@ void FPackage::UpdateDirCache()
   }
   BuildPackageList(RootDir, DirCache, TfcCache);
   LogI("Done. Found %ld packages", DirCache.size());
+  ResetCompositeContainers();
 }
 
-void FPackage::CreateCompositeMod(const std::vector<FString>& items, const FString& destination, FString name, FString author)
+bool CompressPackage(FStream& readStream, FStream& writeStream, PackageSaveContext& context);
+
+std::vector<FCompositeModEntry> FPackage::CreateCompositeMod(const std::vector<FString>& items, const FString& destination, FString name, FString author, bool compress)
 {
-  std::vector<FString> objects;
-  for (const FString& path : items)
-  {
-    FReadStream s(path);
+  // Validate all summaries first. Nothing is written if any of the packages is wrong
+  struct PackageInfo {
+    FString ObjectPath;
+    FString PackageName;
+    bool Compressed = false;
+    std::string Error;
+  };
+  std::vector<PackageInfo> infos(items.size());
+  concurrency::parallel_for(size_t(0), items.size(), [&](size_t idx) {
+    PackageInfo& info = infos[idx];
+    FReadStream s(items[idx]);
     FPackageSummary sum;
     s << sum;
     if (!s.IsGood())
     {
-      UThrow("Failed to read package %s.", path.Filename().C_str());
+      info.Error = Sprintf("Failed to read package %s.", items[idx].Filename().C_str());
+      return;
+    }
+    info.PackageName = sum.PackageName;
+    info.Compressed = sum.CompressedChunks.size() && (sum.PackageFlags & PKG_StoreCompressed);
+    if (sum.FolderName.StartWith("MOD:"))
+    {
+      info.ObjectPath = sum.FolderName.Substr(4);
+    }
+    if (info.ObjectPath.Empty())
+    {
+      info.Error = Sprintf("Package %s has no composite info! Try to resave it from the original.", sum.PackageName.C_str());
+    }
+  });
+
+  FStringMap<size_t> objects;
+  for (size_t idx = 0; idx < items.size(); ++idx)
+  {
+    if (infos[idx].Error.size())
+    {
+      UThrow("%s", infos[idx].Error.c_str());
+    }
+    auto it = objects.emplace(infos[idx].ObjectPath, idx);
+    if (!it.second)
+    {
+      UThrow("%s and %s are modifying the same composite package!", items[idx].Filename().C_str(), items[it.first->second].Filename().C_str());
     }
-    if (!sum.FolderName.StartWith("MOD:"))
+  }
+
+  // Packages are read, compressed and hashed in parallel batches. A batch is written on a separate thread
+  // while the next one is prepared, so at most two batches are held in memory.
+  struct PreparedEntry {
+    std::vector<uint8> Data;
+    std::string Error;
+  };
+  const size_t maxBatchCount = std::max<size_t>(2, std::thread::hardware_concurrency());
+
+  std::vector<FCompositeModEntry> entries(items.size());
+  std::vector<PreparedEntry> batches[2];
+  FWriteStream write(destination);
+  if (!write.IsGood())
+  {
+    UThrow("Failed to create %s.", destination.Filename().C_str());
+  }
+  std::future<void> pendingWrite;
+  size_t batchIndex = 0;
+  for (size_t batchStart = 0; batchStart < items.size(); batchIndex ^= 1)
+  {
+    // Limit the batch by the size of its sources
+    size_t batchEnd = batchStart;
+    uint64 batchSize = 0;
+    std::error_code err;
+    while (batchEnd < items.size() && batchEnd - batchStart < maxBatchCount && (batchEnd == batchStart || batchSize < CompositeModBatchSize))
     {
-      UThrow("Package %s has no composite info! Try to resave it from the original.", sum.PackageName.C_str());
+      batchSize += std::filesystem::file_size(items[batchEnd].WString(), err);
+      batchEnd++;
     }
-    FString objName = sum.FolderName.Substr(4);
-    if (objName.Empty())
+
+    std::vector<PreparedEntry>& batch = batches[batchIndex];
+    batch.clear();
+    batch.resize(batchEnd - batchStart);
+    concurrency::parallel_for(batchStart, batchEnd, [&](size_t idx) {
+      PreparedEntry& entry = batch[idx - batchStart];
+      FReadStream read(items[idx]);
+      const FILE_OFFSET size = read.GetSize();
+      std::vector<uint8> source(size);
+      read.SerializeBytes(source.data(), size);
+      if (!read.IsGood() || size <= 0)
+      {
+        entry.Error = Sprintf("Failed to read package %s.", items[idx].Filename().C_str());
+        return;
+      }
+      if (compress && !infos[idx].Compressed)
+      {
+        MReadStream compressRead(source.data(), false, source.size());
+        MWrightStream compressWrite(nullptr, 0);
+        PackageSaveContext ctx;
+        ctx.Compression = COMPRESS_LZO;
+        if (!CompressPackage(compressRead, compressWrite, ctx))
+        {
+          entry.Error = Sprintf("Failed to compress %s: %s", items[idx].Filename().C_str(), ctx.Error.c_str());
+          return;
+        }
+        const uint8* compressed = (const uint8*)compressWrite.GetAllocation();
+        entry.Data.assign(compressed, compressed + compressWrite.GetSize());
+      }
+      else
+      {
+        entry.Data = std::move(source);
+      }
+      FCompositeModEntry& result = entries[idx];
+      result.Path = items[idx];
+      result.ObjectPath = infos[idx].ObjectPath;
+      result.Size = (FILE_OFFSET)entry.Data.size();
+      result.Hash = HashBuffer(entry.Data.data(), entry.Data.size());
+    });
+
+    if (pendingWrite.valid())
     {
-      UThrow("Package %s has no composite info! Try to resave it from the original.", sum.PackageName.C_str());
+      // Rethrows write errors
+      pendingWrite.get();
     }
-    for (int32 idx = 0; idx < objects.size(); ++idx)
+    for (const PreparedEntry& entry : batch)
     {
-      if (objects[idx] == objName)
+      if (entry.Error.size())
       {
-        UThrow("%s and %s are modifying the same composite package!", path.Filename().C_str(), items[idx].Filename().C_str());
+        UThrow("%s", entry.Error.c_str());
       }
     }
-    objects.push_back(objName);
+    pendingWrite = std::async(std::launch::async, [&write, &entries, &batch, batchStart] {
+      for (size_t idx = 0; idx < batch.size(); ++idx)
+      {
+        entries[batchStart + idx].Offset = write.GetPosition();
+        write.SerializeBytes(batch[idx].Data.data(), (FILE_OFFSET)batch[idx].Data.size());
+        // Release memory as soon as possible
+        std::vector<uint8>().swap(batch[idx].Data);
+      }
+      if (!write.IsGood())
+      {
+        UThrow("Failed to write the mod. Check the destination is available!");
+      }
+    });
+    batchStart = batchEnd;
+  }
+  if (pendingWrite.valid())
+  {
+    pendingWrite.get();
   }
 
   std::vector<FILE_OFFSET> offsets;
-  FWriteStream write(destination);
-  for (const FString& path : items)
+  for (const FCompositeModEntry& entry : entries)
   {
-    FReadStream read(path);
-    FILE_OFFSET size = read.GetSize();
-    void* data = malloc(size);
-    read.SerializeBytes(data, size);
-    offsets.push_back(write.GetPosition());
-    write.SerializeBytes(data, size);
-    free(data);
+    offsets.push_back(entry.Offset);
   }
 
   // Save metadata
@@ -376,6 +589,7 @@ void FPackage::CreateCompositeMod(const std::vector<FString>& items, const FStri
   metaSize = write.GetPosition() - metaSize;
   write.SetPosition(metaSizeOffset);
   write << metaSize;
+  return entries;
 }
 
 std::vector<UClass*> FPackage::GetClasses()
@@ -488,13 +702,13 @@ void FPackage::LoadClassPackage(const FString& name)
         std::scoped_lock<std::mutex> l(ClassMapMutex);
         ClassMap[obj->GetObjectName()] = obj;
       }
-      else if (obj->IsA(UMetaData::StaticClassName()))
+      else if (obj->IsA<UMetaData>())
       {
         meta = (UMetaData*)obj;
       }
       else
       {
-        if (obj->IsA(UProperty::StaticClassName()))
+        if (obj->IsA<UProperty>())
         {
           properties.push_back((UProperty*)obj);
         }
@@ -616,7 +830,7 @@ void FPackage::LoadClassPackage(const FString& name)
         outer = outer->GetOuter();
       }
       const FString className = outer->GetObjectName();
-      if (parents.size() && parents.front()->IsA(UFunction::StaticClassName()))
+      if (parents.size() && parents.front()->IsA<UFunction>())
       {
         continue;
       }
@@ -685,153 +899,406 @@ void FPackage::UnloadDefaultClassPackages()
   DefaultClassPackages.clear();
 }
 
-void FPackage::LoadPkgMapper(bool rebuild)
-{
-  PkgMap.clear();
-  std::filesystem::path storagePath = std::filesystem::path(RootDir.WString()) / PackageMapperName;
-  storagePath.replace_extension(".re");
-  std::filesystem::path encryptedPath = std::filesystem::path(RootDir.WString()) / "CookedPC" / PackageMapperName;
-  encryptedPath.replace_extension(".dat");
-  LogI("Reading %s storage...", PackageMapperName);
+// Splits a decrypted mapper without copying. Fields are views into the mapper buffer.
+class FMapperTokenizer {
+public:
+  FMapperTokenizer(std::string_view data)
+    : Data(data)
+  {}
 
-  uint64 fts = GetFileTime(encryptedPath.wstring());
-  if (std::filesystem::exists(storagePath) && !rebuild)
+  // Read up to the delimiter and skip it. Returns false if there is no delimiter left.
+  bool Next(char delimiter, std::string_view& field)
   {
-    FReadStream rs(storagePath.wstring());
-    uint64 ts = 0;
-    rs << ts;
-    if (fts == ts || !fts)
-    {
-      rs << PkgMap;
-      return;
-    }
-    else
+    const size_t end = Data.find(delimiter, Position);
+    if (end == std::string_view::npos)
     {
-      LogW("%s storage is outdated! Updating...", PackageMapperName);
+      return false;
     }
+    field = Data.substr(Position, end - Position);
+    Position = end + 1;
+    return true;
   }
 
-  if (!std::filesystem::exists(encryptedPath))
+  // Everything after the last delimiter
+  std::string_view Rest() const
   {
-    UThrow("Failed to open %s", encryptedPath.string().c_str());
+    return Position < Data.size() ? Data.substr(Position) : std::string_view();
   }
 
-  FString buffer;
-  DecryptMapper(encryptedPath, buffer);
+private:
+  std::string_view Data;
+  size_t Position = 0;
+};
+
+// Mapper storage (.re) header. The hash of the encrypted mapper lets us skip
+// the rebuild when a patch touched the mapper but didn't change it.
+struct FMapperStorageHeader {
+  uint32 Magic = 0;
+  uint64 Timestamp = 0;
+  uint64 Hash = 0;
+
+  friend FStream& operator<<(FStream& s, FMapperStorageHeader& h)
+  {
+    return s << h.Magic << h.Timestamp << h.Hash;
+  }
+};
+
+// Change when the storage layout changes. Old storages are rebuilt.
+const uint32 MapperStorageMagic = 0x4D455202;
+
+bool ReadMapperStorageHeader(FStream& s, FMapperStorageHeader& header)
+{
+  if (!s.IsGood() || s.GetSize() < (FILE_OFFSET)(sizeof(header.Magic) + sizeof(header.Timestamp) + sizeof(header.Hash)))
+  {
+    return false;
+  }
+  s << header;
+  return s.IsGood() && header.Magic == MapperStorageMagic;
+}
+
+// The header has a fixed size, so the storage can be revalidated in place
+void UpdateMapperStorageHeader(const std::filesystem::path& storagePath, FMapperStorageHeader& header)
+{
+  FWriteStream s(storagePath.wstring(), false);
+  if (s.IsGood())
+  {
+    s << header;
+  }
+}
+
+template <typename TNumber>
+TNumber ParseMapperNumber(const char* mapperName, std::string_view field)
+{
+  TNumber result = 0;
+  auto [end, err] = std::from_chars(field.data(), field.data() + field.size(), result);
+  if (err != std::errc())
+  {
+    UThrow("%s is corrupted!", mapperName);
+  }
+  return result;
+}
+
+// key,value|key,value|...
+template <typename TMap>
+void ParseKeyValueMapper(const char* mapperName, std::string_view data, TMap& map)
+{
+  map.reserve(std::count(data.begin(), data.end(), '|'));
+  FMapperTokenizer records(data);
+  std::string_view record;
+  while (records.Next('|', record))
+  {
+    FMapperTokenizer fields(record);
+    std::string_view key;
+    if (!fields.Next(',', key))
+    {
+      UThrow("%s is corrupted!", mapperName);
+    }
+    std::string_view value = fields.Rest();
+    map.emplace(FString(key.data(), key.size()), FString(value.data(), value.size()));
+  }
+}
 
-  size_t pos = 0;
-  size_t prevPos = 0;
-  while ((pos = buffer.Find('|', prevPos)) != std::string::npos)
+// Loads PkgMapper or ObjectRedirectorMapper through its storage
+template <typename TMap>
+void LoadKeyValueMapper(const char* mapperName, const std::filesystem::path& encryptedPath, const std::filesystem::path& storagePath, bool rebuild, TMap& map)
+{
+  LogI("Reading %s storage...", mapperName);
+  const uint64 fts = GetFileTime(encryptedPath.wstring());
+  FMapperStorageHeader header;
+  std::unique_ptr<FReadStream> storage;
+  if (std::filesystem::exists(storagePath) && !rebuild)
   {
-    size_t sepPos = buffer.Find(',', prevPos);
-    if (sepPos == std::string::npos || sepPos > pos)
+    storage = std::make_unique<FReadStream>(storagePath.wstring());
+    if (!ReadMapperStorageHeader(*storage, header))
+    {
+      storage.reset();
+    }
+    else if (fts == header.Timestamp || !fts)
+    {
+      *storage << map;
+      return;
+    }
+    else
     {
-      UThrow("%s is corrupted!", PackageMapperName);
+      LogW("%s storage is outdated! Updating...", mapperName);
     }
-    FString key = buffer.Substr(prevPos, sepPos - prevPos).ToUpper();
-    FString value = buffer.Substr(sepPos + 1, pos - sepPos - 1);
-    PkgMap.emplace(key, value);
-    pos++;
-    std::swap(pos, prevPos);
   }
 
-  LogI("Saving %s storage", PackageMapperName);
+  std::vector<char> encrypted;
+  ReadMapper(encryptedPath, encrypted);
+  const uint64 hash = HashBuffer(encrypted.data(), encrypted.size());
+  if (storage && header.Hash == hash)
+  {
+    LogI("%s has not changed", mapperName);
+    *storage << map;
+    storage.reset();
+    header.Timestamp = fts;
+    UpdateMapperStorageHeader(storagePath, header);
+    return;
+  }
+  storage.reset();
+
+  FString buffer;
+  LogI("Decrypting \"%s\"", encryptedPath.filename().string().c_str());
+  DecryptMapper(encrypted, buffer);
+  ParseKeyValueMapper(mapperName, buffer.View().View(), map);
+
+  LogI("Saving %s storage", mapperName);
+  header.Magic = MapperStorageMagic;
+  header.Timestamp = fts;
+  header.Hash = hash;
   FWriteStream ws(storagePath.wstring());
-  ws << fts;
-  ws << PkgMap;
+  ws << header;
+  ws << map;
 
 #if DUMP_MAPPERS
   std::filesystem::path debugPath = storagePath;
   debugPath.replace_extension(".txt");
-  std::ofstream os(debugPath.wstring());
+  std::ofstream os(debugPath.wstring(), std::ios::out | std::ios::binary | std::ios::trunc);
   os.write(&buffer[0], buffer.Size());
 #endif
 }
 
+// Composite mapper file group: FileName?entry|entry|...!
+struct FCompositeMapperGroup {
+  std::string_view FileName;
+  std::string_view Body;
+  uint64 Hash = 0;
+  std::vector<std::pair<FString, FCompositePackageMapEntry>> Entries;
+};
+
+// Hash of the loaded composite mapper and of each of its groups. Refresh reparses changed groups only.
+uint64 CompositeMapperHash = 0;
+FStringMap<uint64> CompositeMapperGroupHashes;
+
+void SplitCompositeMapper(std::string_view data, std::vector<FCompositeMapperGroup>& groups)
+{
+  FMapperTokenizer tokenizer(data);
+  std::string_view fileName;
+  while (tokenizer.Next('?', fileName))
+  {
+    FCompositeMapperGroup& group = groups.emplace_back();
+    group.FileName = fileName;
+    if (!tokenizer.Next('!', group.Body))
+    {
+      UThrow("%s is corrupted!", CompositePackageMapperName);
+    }
+    group.Hash = HashBuffer(group.Body.data(), group.Body.size());
+  }
+}
+
+// ObjectPath,PackageName,Offset,Size,|...
+void ParseCompositeMapperGroup(FCompositeMapperGroup& group)
+{
+  const FString fileName(group.FileName.data(), group.FileName.size());
+  auto parseEntry = [&](std::string_view entry) {
+    FMapperTokenizer fields(entry);
+    std::string_view objectPath;
+    std::string_view packageName;
+    std::string_view offset;
+    std::string_view size;
+    if (!fields.Next(',', objectPath) || !fields.Next(',', packageName) || !fields.Next(',', offset))
+    {
+      UThrow("%s is corrupted!", CompositePackageMapperName);
+    }
+    if (!fields.Next(',', size))
+    {
+      size = fields.Rest();
+    }
+    auto& item = group.Entries.emplace_back();
+    item.first = FString(packageName.data(), packageName.size());
+    item.second.FileName = fileName;
+    item.second.ObjectPath = FString(objectPath.data(), objectPath.size());
+    item.second.Offset = (FILE_OFFSET)ParseMapperNumber<uint32>(CompositePackageMapperName, offset);
+    item.second.Size = (FILE_OFFSET)ParseMapperNumber<uint32>(CompositePackageMapperName, size);
+  };
+
+  FMapperTokenizer entries(group.Body);
+  std::string_view entry;
+  while (entries.Next('|', entry))
+  {
+    if (entry.size())
+    {
+      parseEntry(entry);
+    }
+  }
+  if (entries.Rest().size())
+  {
+    parseEntry(entries.Rest());
+  }
+}
+
+void FPackage::LoadPkgMapper(bool rebuild)
+{
+  PkgMap.clear();
+  std::filesystem::path storagePath = std::filesystem::path(RootDir.WString()) / PackageMapperName;
+  storagePath.replace_extension(".re");
+  std::filesystem::path encryptedPath = std::filesystem::path(RootDir.WString()) / "CookedPC" / PackageMapperName;
+  encryptedPath.replace_extension(".dat");
+  LoadKeyValueMapper(PackageMapperName, encryptedPath, storagePath, rebuild, PkgMap);
+}
+
 void FPackage::LoadCompositePackageMapper(bool rebuild)
 {
   {
     std::scoped_lock<std::mutex> l(MissingPackagesMutex);
     MissingPackages.clear();
   }
-  CompositPackageMap.clear();
-  CompositPackageList.clear();
   std::filesystem::path encryptedPath = std::filesystem::path(RootDir.WString()) / "CookedPC" / CompositePackageMapperName;
   encryptedPath.replace_extension(".dat");
 
+  if (rebuild)
+  {
+    // Reparse every group
+    CompositPackageMap.clear();
+    CompositPackageList.clear();
+    CompositeMapperGroupHashes.clear();
+    CompositeMapperHash = 0;
+  }
+
+  auto rebuildList = [] {
+    CompositPackageList.clear();
+    for (const auto& pair : CompositPackageMap)
+    {
+      CompositPackageList[pair.second.FileName].push_back(pair.first);
+    }
+  };
+
 #if CACHE_COMPOSITE_MAP
   LogI("Reading %s storage...", CompositePackageMapperName);
   std::filesystem::path storagePath = std::filesystem::path(RootDir.WString()) / CompositePackageMapperName;
   storagePath.replace_extension(".re");
-  uint64 fts = GetFileTime(encryptedPath.wstring());
+  const uint64 fts = GetFileTime(encryptedPath.wstring());
+  FMapperStorageHeader header;
   if (std::filesystem::exists(storagePath) && !rebuild)
   {
     FReadStream s(storagePath.wstring());
-    uint64 ts = 0;
-    s << ts;
-    if (fts == ts || !fts)
+    if (ReadMapperStorageHeader(s, header))
     {
-      s << CompositPackageMap;
-      for (auto pair : CompositPackageMap)
+      const bool upToDate = fts == header.Timestamp || !fts;
+      if (upToDate || CompositPackageMap.empty())
       {
-        CompositPackageList[pair.second.FileName.ToUpper()].push_back(pair.first);
+        // An outdated storage is still a good base for the refresh below
+        s << CompositeMapperGroupHashes;
+        s << CompositPackageMap;
+        CompositeMapperHash = header.Hash;
+        rebuildList();
+      }
+      if (upToDate)
+      {
+        return;
       }
-      return;
-    }
-    else
-    {
       LogW("%s storage is outdated! Updating...", CompositePackageMapperName);
     }
   }
 #endif
 
-  FString buffer;
-  DecryptMapper(encryptedPath, buffer);
-
-  size_t pos = 0;
-  size_t posEnd = 0;
-  while ((pos = buffer.Find('?', posEnd)) != std::string::npos)
+  std::vector<char> encrypted;
+  ReadMapper(encryptedPath, encrypted);
+  const uint64 hash = HashBuffer(encrypted.data(), encrypted.size());
+  if (hash == CompositeMapperHash && CompositPackageMap.size())
   {
-    FString fileName = buffer.Substr(posEnd, pos - posEnd);
-    posEnd = buffer.Find('!', pos);
-    do
+    LogI("%s has not changed", CompositePackageMapperName);
+#if CACHE_COMPOSITE_MAP
+    if (header.Magic == MapperStorageMagic && header.Hash == hash)
     {
-      pos++;
-      FCompositePackageMapEntry entry;
-      entry.FileName = fileName;
+      header.Timestamp = fts;
+      UpdateMapperStorageHeader(storagePath, header);
+      return;
+    }
+#else
+    return;
+#endif
+  }
+
+  FString buffer;
+  LogI("Decrypting \"%s\"", encryptedPath.filename().string().c_str());
+  DecryptMapper(encrypted, buffer);
 
-      size_t elementEnd = buffer.Find(',', pos);
-      entry.ObjectPath = buffer.Substr(pos, elementEnd - pos);
-      std::swap(pos, elementEnd);
-      pos++;
+  std::vector<FCompositeMapperGroup> groups;
+  size_t changedGroups = 0;
+  try
+  {
+    SplitCompositeMapper(buffer.View().View(), groups);
 
-      elementEnd = buffer.Find(',', pos);
-      FString packageName = buffer.Substr(pos, elementEnd - pos);
-      std::swap(pos, elementEnd);
-      pos++;
+    FStringMap<uint64> groupHashes;
+    groupHashes.reserve(groups.size());
+    std::vector<FCompositeMapperGroup*> changed;
+    for (FCompositeMapperGroup& group : groups)
+    {
+      FString fileName(group.FileName.data(), group.FileName.size());
+      auto it = CompositeMapperGroupHashes.find(fileName);
+      if (it == CompositeMapperGroupHashes.end() || it->second != group.Hash)
+      {
+        changed.push_back(&group);
+      }
+      groupHashes[fileName] = group.Hash;
+    }
 
-      elementEnd = buffer.Find(',', pos);
-      entry.Offset = (FILE_OFFSET)std::stoul(buffer.Substr(pos, elementEnd - pos).String());
-      std::swap(pos, elementEnd);
-      pos++;
+    // Drop packages of the groups that were changed or removed
+    for (const auto& pair : CompositeMapperGroupHashes)
+    {
+      auto it = groupHashes.find(pair.first);
+      if (it != groupHashes.end() && it->second == pair.second)
+      {
+        continue;
+      }
+      auto listIt = CompositPackageList.find(pair.first);
+      if (listIt == CompositPackageList.end())
+      {
+        continue;
+      }
+      for (const FString& packageName : listIt->second)
+      {
+        auto entryIt = CompositPackageMap.find(packageName);
+        if (entryIt != CompositPackageMap.end() && entryIt->second.FileName == pair.first)
+        {
+          CompositPackageMap.erase(entryIt);
+        }
+      }
+      CompositPackageList.erase(listIt);
+    }
 
-      elementEnd = buffer.Find(',', pos);
-      entry.Size = (FILE_OFFSET)std::stoul(buffer.Substr(pos, elementEnd - pos).String());
-      std::swap(pos, elementEnd);
-      pos++;
+    // Groups are independent, so they can be parsed in parallel
+    concurrency::parallel_for(size_t(0), changed.size(), [&](size_t idx) {
+      ParseCompositeMapperGroup(*changed[idx]);
+    });
 
-      DBreakIf(CompositPackageMap.count(packageName));
-      CompositPackageMap[packageName] = entry;
-      CompositPackageList[fileName].push_back(packageName);
-    } while (buffer.Find('|', pos) < posEnd - 1);
-    pos++;
-    posEnd++;
+    for (FCompositeMapperGroup* group : changed)
+    {
+      std::vector<FString>& list = CompositPackageList[FString(group->FileName.data(), group->FileName.size())];
+      list.clear();
+      list.reserve(group->Entries.size());
+      for (auto& item : group->Entries)
+      {
+        DBreakIf(CompositPackageMap.count(item.first));
+        list.push_back(item.first);
+        CompositPackageMap[item.first] = std::move(item.second);
+      }
+    }
+    changedGroups = changed.size();
+    CompositeMapperGroupHashes = std::move(groupHashes);
+    CompositeMapperHash = hash;
+  }
+  catch (...)
+  {
+    // Don't leave a half updated map behind
+    CompositPackageMap.clear();
+    CompositPackageList.clear();
+    CompositeMapperGroupHashes.clear();
+    CompositeMapperHash = 0;
+    throw;
   }
+  LogI("%s: updated %llu of %llu groups", CompositePackageMapperName, (unsigned long long)changedGroups, (unsigned long long)groups.size());
 
 #if CACHE_COMPOSITE_MAP
   LogI("Saving %s storage", CompositePackageMapperName);
+  header.Magic = MapperStorageMagic;
+  header.Timestamp = fts;
+  header.Hash = hash;
   FWriteStream s(storagePath.wstring());
-  s << fts;
+  s << header;
+  s << CompositeMapperGroupHashes;
   s << CompositPackageMap;
 #endif
 
@@ -850,56 +1317,20 @@ void FPackage::LoadObjectRedirectorMapper(bool rebuild)
   storagePath.replace_extension(".re");
   std::filesystem::path encryptedPath = std::filesystem::path(RootDir.WString()) / "CookedPC" / ObjectRedirectorMapperName;
   encryptedPath.replace_extension(".dat");
-  LogI("Reading %s storage...", ObjectRedirectorMapperName);
-  uint64 fts = GetFileTime(encryptedPath.wstring());
-  if (std::filesystem::exists(storagePath) && !rebuild)
+  LoadKeyValueMapper(ObjectRedirectorMapperName, encryptedPath, storagePath, rebuild, ObjectRedirectorMap);
+}
+
+void ValidatePackageVersion(const FPackageSummary& sum, uint16 coreVersion)
+{
+  if (coreVersion && sum.GetFileVersion() != coreVersion)
   {
-    FReadStream rs(storagePath.wstring());
-    uint64 ts = 0;
-    rs << ts;
-    if (fts == ts || !fts)
-    {
-      rs << ObjectRedirectorMap;
-      return;
-    }
-    else
+    if (sum.GetFileVersion() == VER_TERA_CLASSIC)
     {
-      LogW("%s storage is outdated! Updating...", ObjectRedirectorMapperName);
+      UThrow("Real Editor can't open 32-bit packages!");
     }
+    UThrow("%s version (%d/%d) differs from your game version(%d)", sum.PackageName.C_str(), sum.GetFileVersion(), sum.GetLicenseeVersion(), coreVersion);
   }
-
-  FString buffer;
-  DecryptMapper(encryptedPath, buffer);
-  
-  size_t pos = 0;
-  size_t prevPos = 0;
-  while ((pos = buffer.Find('|', prevPos)) != std::string::npos)
-  {
-    size_t sepPos = buffer.Find(',', prevPos);
-    if (sepPos == std::string::npos || sepPos > pos)
-    {
-      UThrow("%s is corrupted!", ObjectRedirectorMapperName);
-    }
-    FString key = buffer.Substr(prevPos, sepPos - prevPos);
-    FString value = buffer.Substr(sepPos + 1, pos - sepPos - 1);
-    ObjectRedirectorMap.emplace(key, value);
-    pos++;
-    std::swap(pos, prevPos);
-  }
-  
-  LogI("Saving %s storage", ObjectRedirectorMapperName);
-  FWriteStream ws(storagePath.wstring());
-  ws << fts;
-  ws << ObjectRedirectorMap;
-
-#if DUMP_MAPPERS
-  std::filesystem::path debugPath = storagePath;
-  debugPath.replace_extension(".txt");
-  std::ofstream os(debugPath.wstring(), std::ios::out | std::ios::binary | std::ios::trunc);
-  os.write(&buffer[0], buffer.Size());
-  os.close();
-#endif
-}
+}
 
 std::shared_ptr<FPackage> FPackage::GetPackage(const FString& path)
 {
@@ -935,13 +1366,14 @@ std::shared_ptr<FPackage> FPackage::GetPackage(const FString& path)
   sum.DataPath = path;
   sum.PackageName = std::filesystem::path(path.WString()).filename().wstring();
   (*stream) << sum;
-  if (CoreVersion && sum.GetFileVersion() != CoreVersion)
+  try
   {
-    if (sum.GetFileVersion() == VER_TERA_CLASSIC)
-    {
-      UThrow("Real Editor can't open 32-bit packages!");
-    }
-    UThrow("%s version (%d/%d) differs from your game version(%d)", sum.PackageName.C_str(), sum.GetFileVersion(), sum.GetLicenseeVersion(), CoreVersion);
+    ValidatePackageVersion(sum, CoreVersion);
+  }
+  catch (...)
+  {
+    delete stream;
+    throw;
   }
   if (sum.CompressedChunks.size())
   {
@@ -1026,11 +1458,134 @@ std::shared_ptr<FPackage> FPackage::GetPackage(const FString& path)
   }
   
   delete stream;
-  std::shared_ptr<FPackage> result = nullptr;
+  std::shared_ptr<FPackage> result(new FPackage(sum));
+  std::scoped_lock<std::recursive_mutex> lock(PackagesMutex);
+  // Parallel import resolving may open the same file on several threads. Keep the first copy
+  for (auto package : LoadedPackages)
   {
-    std::scoped_lock<std::recursive_mutex> lock(PackagesMutex);
-    result = LoadedPackages.emplace_back(new FPackage(sum));
+    if (package->GetSourcePath() == path)
+    {
+      return LoadedPackages.emplace_back(package);
+    }
+  }
+  return LoadedPackages.emplace_back(result);
+}
+
+std::shared_ptr<FPackage> FPackage::GetPackageFromMemory(std::shared_ptr<uint8> data, FILE_OFFSET size, const FString& path)
+{
+  std::shared_ptr<FPackage> result = CreatePackageFromMemory(data, size, path);
+  std::scoped_lock<std::recursive_mutex> lock(PackagesMutex);
+  return LoadedPackages.emplace_back(result);
+}
+
+std::shared_ptr<FPackage> FPackage::CreatePackageFromMemory(std::shared_ptr<uint8> data, FILE_OFFSET size, const FString& path)
+{
+  FPackageSummary sum;
+  sum.SourcePath = path;
+  sum.DataPath = path;
+  sum.PackageName = std::filesystem::path(path.WString()).filename().wstring();
+  {
+    MReadStream stream(data.get(), false, size);
+    stream << sum;
+    if (!stream.IsGood())
+    {
+      UThrow("Failed to read %s!", sum.PackageName.C_str());
+    }
+  }
+  ValidatePackageVersion(sum, CoreVersion);
+
+  if (sum.CompressedChunks.size())
+  {
+    FILE_OFFSET startOffset = INT_MAX;
+    FILE_OFFSET totalDecompressedSize = 0;
+    for (const FCompressedChunk& chunk : sum.CompressedChunks)
+    {
+      if (chunk.CompressedOffset < 0 || chunk.CompressedOffset + chunk.CompressedSize > size)
+      {
+        UThrow("%s is corrupted!", sum.PackageName.C_str());
+      }
+      totalDecompressedSize += chunk.DecompressedSize;
+      startOffset = std::min(startOffset, chunk.DecompressedOffset);
+    }
+
+    sum.OriginalPackageFlags = sum.PackageFlags;
+    sum.OriginalCompressionFlags = sum.CompressionFlags;
+    sum.PackageFlags &= ~PKG_StoreCompressed;
+    sum.CompressionFlags = COMPRESS_None;
+
+    std::vector<FCompressedChunk> chunks;
+    std::swap(sum.CompressedChunks, chunks);
+
+    // Same layout as a decompressed temp file: the summary without chunks followed by the data
+    MWrightStream header(nullptr, 0);
+    auto tmpSize = sum.SourceSize;
+    header << sum;
+    sum.SourceSize = tmpSize;
+    const FILE_OFFSET headerSize = header.GetPosition();
+
+    LogI("Decompressing package %s to memory", sum.PackageName.C_str());
+    std::shared_ptr<uint8> decompressedData((uint8*)malloc(headerSize + totalDecompressedSize), free);
+    memcpy(decompressedData.get(), header.GetAllocation(), headerSize);
+    const uint8* compressedData = data.get();
+    uint8* dstData = decompressedData.get() + headerSize;
+    concurrency::parallel_for(size_t(0), size_t(chunks.size()), [&chunks, compressedData, dstData, startOffset](size_t idx) {
+      const FCompressedChunk& chunk = chunks[idx];
+      LZO::Decompress(compressedData + chunk.CompressedOffset, chunk.CompressedSize, dstData + chunk.DecompressedOffset - startOffset, chunk.DecompressedSize);
+    });
+
+    data = decompressedData;
+    size = headerSize + totalDecompressedSize;
+
+    // Read decompressed header
+    MReadStream stream(data.get(), false, size);
+    stream << sum;
+  }
+
+  std::shared_ptr<FPackage> result(new FPackage(sum));
+  result->DataBuffer = data;
+  result->DataBufferSize = size;
+  return result;
+}
+
+std::unique_ptr<FStream> FPackage::CreateDataStream() const
+{
+  std::unique_ptr<FStream> stream;
+  if (DataBuffer)
+  {
+    stream = std::make_unique<MReadStream>(DataBuffer.get(), false, DataBufferSize);
+  }
+  else
+  {
+    stream = std::make_unique<FReadStream>(Summary.DataPath);
+  }
+  stream->SetPackage(const_cast<FPackage*>(this));
+  return stream;
+}
+
+bool FPackage::ReadDeferredData(FILE_OFFSET& offset, const std::function<void(FStream&)>& read) const
+{
+  if (offset == INDEX_NONE)
+  {
+    return true;
   }
+  bool result = false;
+  try
+  {
+    std::unique_ptr<FStream> s = CreateDataStream();
+    if (s->IsGood())
+    {
+      s->SetPosition(offset);
+      read(*s);
+      // Short reads don't throw
+      result = s->IsGood();
+    }
+  }
+  catch (const std::exception& e)
+  {
+    LogE("%s: Failed to read data at 0x%08X: %s", GetPackageName().C_str(), offset, e.what());
+  }
+  // Don't retry a failed read on every access
+  offset = INDEX_NONE;
   return result;
 }
 
@@ -1078,52 +1633,31 @@ std::shared_ptr<FPackage> FPackage::GetPackageNamed(const FString& name, FGuid g
   if (CoreVersion > VER_TERA_CLASSIC && CompositPackageMap.count(name))
   {
     const FCompositePackageMapEntry& entry = CompositPackageMap[name];
-    FString packagePath;
-    for (FString& path : DirCache)
-    {
-      std::wstring filename = path.FilenameWString();
-      if (filename.size() < entry.FileName.Size())
-      {
-        continue;
-      }
-      std::wstring tmp = entry.FileName.WString();
-      if (std::mismatch(tmp.begin(), tmp.end(), filename.begin()).first == tmp.end())
-      {
-        packagePath = RootDir.FStringByAppendingPath(path);
-        break;
-      }
-    }
+    FString packagePath = FindCompositeContainer(entry.FileName, RootDir, DirCache);
     if (packagePath.Size())
     {
       LogI("Reading composite package %s from %s...", name.C_str(), entry.FileName.C_str());
-      void* rawData = malloc(entry.Size);
+      std::shared_ptr<uint8> rawData((uint8*)malloc(entry.Size), free);
+      if (!ReadCompositeSlice(packagePath, entry.Offset, entry.Size, rawData.get()))
       {
-        FReadStream rs(packagePath);
-        rs.SetPosition(entry.Offset);
-        rs.SerializeBytes(rawData, entry.Size);
-        if (!rs.IsGood())
-        {
-          UThrow("Failed to read %s", name.C_str());
-        }
-      }
-      std::filesystem::path tmpPath = std::filesystem::temp_directory_path() / std::tmpnam(nullptr);
-      LogI("Writing composite package %s to %s...", name.C_str(), tmpPath.string().c_str());
-      {
-        FWriteStream ws(tmpPath);
-        ws.SerializeBytes(rawData, entry.Size);
-        if (!ws.IsGood())
-        {
-          UThrow("Failed to save composit package %s to %s", name.C_str(), tmpPath.string().c_str());
-        }
+        UThrow("Failed to read %s", name.C_str());
       }
-      free(rawData);
-      std::shared_ptr<FPackage> package = GetPackage(tmpPath.wstring());
-      package->CompositeDataPath = tmpPath.wstring();
+      std::shared_ptr<FPackage> package = CreatePackageFromMemory(rawData, entry.Size, packagePath.FStringByAppendingPath(name));
       package->CompositeSourcePath = packagePath.WString();
       package->Summary.PackageName = name;
       package->Composite = true;
       package->AllowForcedExportResolving = false;
-      return package;
+
+      // Publish the package only when it is set up. Another thread may have opened it meanwhile
+      std::scoped_lock<std::recursive_mutex> lock(PackagesMutex);
+      for (auto existing : LoadedPackages)
+      {
+        if (existing->GetPackageName() == name && (!guid.IsValid() || existing->GetGuid() == guid))
+        {
+          return LoadedPackages.emplace_back(existing);
+        }
+      }
+      return LoadedPackages.emplace_back(package);
     }
   }
 
@@ -1194,6 +1728,7 @@ void FPackage::UnloadPackage(std::shared_ptr<FPackage> package)
 
 FPackage::~FPackage()
 {
+  ForgetResolvedImports(this);
   if (Stream)
   {
     delete Stream;
@@ -1232,22 +1767,39 @@ FPackage::~FPackage()
   {
     std::filesystem::remove(std::filesystem::path(Summary.DataPath.WString()));
   }
-  if (CompositeDataPath.Size())
-  {
-    std::filesystem::remove(std::filesystem::path(CompositeDataPath.WString()));
-  }
 }
 
 void FPackage::Load()
 {
-#define CheckCancel() if (Cancelled.load()) { Loading.store(false); return; } //
-  if (Ready.load() || Loading.load())
+  if (Ready.load())
   {
     return;
   }
-  Loading.store(true);
-  Stream = new FReadStream(Summary.DataPath);
-  Stream->SetPackage(this);
+  // Late callers wait here until the first one is done, so nobody sees the tables half-read
+  std::scoped_lock<std::mutex> lock(LoadMutex);
+  if (Ready.load() || Cancelled.load())
+  {
+    return;
+  }
+  if (LoadFailed.load())
+  {
+    UThrow("Failed to load %s!", GetPackageName().C_str());
+  }
+  try
+  {
+    ReadTables();
+  }
+  catch (...)
+  {
+    LoadFailed.store(true);
+    throw;
+  }
+}
+
+void FPackage::ReadTables()
+{
+#define CheckCancel() if (Cancelled.load()) { return; } //
+  Stream = CreateDataStream().release();
   FStream& s = GetStream();
   if (Summary.NamesOffset != s.GetPosition())
   {
@@ -1350,83 +1902,358 @@ void FPackage::Load()
       s << ImportGuids[idx];
     }
 
-    ExportGuids.clear();
-    for (int32 idx = 0; idx < Summary.ExportGuidsCount; ++idx)
-    {
-      FGuid objectGuid;
-      PACKAGE_INDEX exportIndex = 0;
-      s << objectGuid << exportIndex;
-      ExportGuids[objectGuid] = GetExportObject(exportIndex);
-    }
+    ExportGuids.clear();
+    for (int32 idx = 0; idx < Summary.ExportGuidsCount; ++idx)
+    {
+      FGuid objectGuid;
+      PACKAGE_INDEX exportIndex = 0;
+      s << objectGuid << exportIndex;
+      ExportGuids[objectGuid] = GetExportObject(exportIndex);
+    }
+  }
+
+  for (uint32 index = 0; index < Summary.ExportsCount; ++index)
+  {
+    FObjectExport* exp = Exports[index];
+#ifdef _DEBUG
+    exp->Path = exp->GetObjectPath();
+#endif
+    if (exp->OuterIndex)
+    {
+      ExportObjects[exp->ObjectIndex]->SetOuter(ExportObjects[exp->OuterIndex]);
+      ExportObjects[exp->OuterIndex]->AddInner(ExportObjects[exp->ObjectIndex]);
+
+      FObjectExport* outer = GetExportObject(exp->OuterIndex);
+      outer->Inner.push_back(exp);
+      exp->Outer = outer;
+    }
+    else
+    {
+      RootExports.push_back(exp);
+    }
+    CheckCancel();
+    ObjectNameToExportMap[exp->GetObjectName()].push_back(exp);
+  }
+
+  for (uint32 idx = 0; idx < Summary.ImportsCount; ++idx)
+  {
+    CheckCancel();
+    FObjectImport* imp = Imports[idx];
+#ifdef _DEBUG
+    imp->Path = imp->GetObjectPath();
+#endif
+    if (imp->OuterIndex)
+    {
+      if (imp->OuterIndex < 0)
+      {
+        FObjectImport* outer = GetImportObject(imp->OuterIndex);
+        outer->Inner.push_back(imp);
+      }
+    }
+    else
+    {
+      RootImports.push_back(imp);
+    }
+  }
+
+#if _DEBUG
+  for (FObjectExport* exp : Exports)
+  {
+    if (exp->ExportFlags & EF_ScriptPatcherExport)
+    {
+      // If here: probably need to apply stack frames, patch the export table and fix net count
+      DBreak();
+    }
+  }
+#endif
+
+#if DUMP_PACKAGES
+  _DebugDump();
+#endif
+
+  // Not bulletproof. Will work only for exposed packages
+  if (CompositPackageList.count(GetPackageName()))
+  {
+    Composite = true;
+  }
+
+  Ready.store(true);
+}
+
+// Copy size bytes from the current position of src to dst through a reusable buffer
+bool CopyStreamData(FStream& src, FStream& dst, FILE_OFFSET size, std::vector<uint8>& buffer)
+{
+  if (buffer.size() < SAVE_COPY_BUFFER_SIZE)
+  {
+    buffer.resize(SAVE_COPY_BUFFER_SIZE);
+  }
+  while (size > 0)
+  {
+    const FILE_OFFSET chunkSize = std::min<FILE_OFFSET>(size, (FILE_OFFSET)buffer.size());
+    src.SerializeBytes(buffer.data(), chunkSize);
+    dst.SerializeBytes(buffer.data(), chunkSize);
+    if (!src.IsGood() || !dst.IsGood())
+    {
+      return false;
+    }
+    size -= chunkSize;
+  }
+  return true;
+}
+
+void AppendZeroed(FStream& s, FILE_OFFSET size)
+{
+  static uint8 zeroes[0x10000] = {};
+  while (size > 0)
+  {
+    const FILE_OFFSET chunkSize = std::min<FILE_OFFSET>(size, sizeof(zeroes));
+    s.SerializeBytes(zeroes, chunkSize);
+    size -= chunkSize;
+  }
+}
+
+bool FPackage::LoadAllExports(int32 parallelism)
+{
+  if (parallelism <= 0)
+  {
+    parallelism = std::max<int32>(1, (int32)std::thread::hardware_concurrency());
+  }
+
+  // Split exports into waves. An export goes after its outer and class if they are exports of this package
+  const PACKAGE_INDEX count = (PACKAGE_INDEX)Exports.size();
+  std::vector<int32> depths(count, INDEX_NONE);
+  const int32 visiting = -2;
+  std::function<int32(PACKAGE_INDEX)> getDepth = [&](PACKAGE_INDEX idx) -> int32 {
+    if (depths[idx] == visiting)
+    {
+      // Broken tables. Don't hang on a cycle
+      return 0;
+    }
+    if (depths[idx] != INDEX_NONE)
+    {
+      return depths[idx];
+    }
+    depths[idx] = visiting;
+    int32 depth = 0;
+    const FObjectExport* exp = Exports[idx];
+    for (PACKAGE_INDEX dependency : { exp->OuterIndex, exp->ClassIndex })
+    {
+      if (dependency > 0 && dependency <= count)
+      {
+        depth = std::max(depth, getDepth(dependency - 1) + 1);
+      }
+    }
+    return depths[idx] = depth;
+  };
+
+  std::vector<std::vector<FObjectExport*>> waves;
+  for (PACKAGE_INDEX idx = 0; idx < count; ++idx)
+  {
+    const int32 depth = getDepth(idx);
+    if (depth >= (int32)waves.size())
+    {
+      waves.resize(depth + 1);
+    }
+    waves[depth].push_back(Exports[idx]);
+  }
+
+  bool result = true;
+  for (const std::vector<FObjectExport*>& wave : waves)
+  {
+    result &= LoadExports(wave, parallelism);
+  }
+  return result;
+}
+
+bool FPackage::LoadExports(std::vector<FObjectExport*> exports, int32 parallelism)
+{
+  if (parallelism <= 0)
+  {
+    parallelism = std::max<int32>(1, (int32)std::thread::hardware_concurrency());
+  }
+  if (!GetStream().GetLoadSerializedObjects())
+  {
+    return true;
+  }
+
+  // Split exports into ranges that are read with a single call. Exports are sorted by offset and
+  // neighbours are merged if the gap between them is small. Ranges are limited in size so every worker gets some.
+  std::sort(exports.begin(), exports.end(), [](FObjectExport* a, FObjectExport* b) {
+    return a->SerialOffset < b->SerialOffset;
+  });
+  FILE_OFFSET totalSize = 0;
+  for (FObjectExport* exp : exports)
+  {
+    totalSize += exp->SerialSize;
+  }
+  const FILE_OFFSET maxRangeSize = std::clamp<FILE_OFFSET>(totalSize / (parallelism * 4), ReadAheadMinRangeSize, ReadAheadMaxRangeSize);
+
+  struct ReadRange {
+    FILE_OFFSET Offset = 0;
+    FILE_OFFSET Size = 0;
+    size_t First = 0;
+    size_t Last = 0;
+  };
+  std::vector<ReadRange> ranges;
+  for (size_t idx = 0; idx < exports.size(); ++idx)
+  {
+    const FObjectExport* exp = exports[idx];
+    if (ranges.size())
+    {
+      ReadRange& range = ranges.back();
+      const FILE_OFFSET end = exp->SerialOffset + exp->SerialSize;
+      if (exp->SerialOffset - (range.Offset + range.Size) <= ReadAheadMaxGap && end - range.Offset <= maxRangeSize)
+      {
+        range.Size = std::max(range.Size, end - range.Offset);
+        range.Last = idx;
+        continue;
+      }
+    }
+    ranges.push_back({ exp->SerialOffset, exp->SerialSize, idx, idx });
+  }
+
+  // In-memory packages have nothing to read ahead. Exports are loaded from the package buffer.
+  const bool readAhead = !DataBuffer;
+  std::atomic_bool result = { true };
+  std::atomic<size_t> next = { 0 };
+  const size_t workers = std::min<size_t>(parallelism, ranges.size());
+  concurrency::parallel_for(size_t(0), workers, [&](size_t) {
+    std::unique_ptr<FStream> stream = CreateDataStream();
+    stream->SetLoadSerializedObjects(GetStream().GetLoadSerializedObjects());
+    std::vector<uint8> buffer;
+    // Workers pull ranges one by one, so a few heavy objects don't stall the rest
+    for (size_t rangeIdx = next++; rangeIdx < ranges.size(); rangeIdx = next++)
+    {
+      const ReadRange& range = ranges[rangeIdx];
+      if (readAhead)
+      {
+        buffer.resize(range.Size);
+        stream->SerializeBytesAt(buffer.data(), range.Offset, range.Size);
+        if (!stream->IsGood())
+        {
+          LogE("%s: Failed to read 0x%08X bytes at 0x%08X", GetPackageName().C_str(), range.Size, range.Offset);
+          result = false;
+          return;
+        }
+      }
+      for (size_t idx = range.First; idx <= range.Last; ++idx)
+      {
+        UObject* obj = GetCachedExportObject(exports[idx]->ObjectIndex);
+        if (!obj)
+        {
+          continue;
+        }
+        try
+        {
+          if (readAhead)
+          {
+            MSliceReadStream slice(stream.get(), buffer.data(), range.Offset, range.Size);
+            obj->Load(slice);
+          }
+          else
+          {
+            obj->Load(*stream);
+          }
+        }
+        catch (const std::exception& e)
+        {
+          LogE("Failed to load %s: %s", obj->GetFullObjectName().C_str(), e.what());
+        }
+        if (obj->GetLoadState() == ObjectLoadState::Failed)
+        {
+          result = false;
+        }
+      }
+    }
+  });
+  return result;
+}
+
+// Compress everything after the summary of an uncompressed package into COMPRESSED_BLOCK_SIZE chunks.
+// Blocks are compressed in parallel, a bounded batch at a time.
+bool CompressPackage(FStream& readStream, FStream& writeStream, PackageSaveContext& context)
+{
+  FPackageSummary summary;
+  readStream.SetPosition(0);
+  readStream << summary;
+  const FILE_OFFSET dataStart = readStream.GetPosition();
+  const FILE_OFFSET size = readStream.GetSize() - dataStart;
+  if (!readStream.IsGood() || size <= 0)
+  {
+    context.Error = "Failed to read source package.";
+    return false;
   }
 
-  for (uint32 index = 0; index < Summary.ExportsCount; ++index)
-  {
-    FObjectExport* exp = Exports[index];
-#ifdef _DEBUG
-    exp->Path = exp->GetObjectPath();
-#endif
-    if (exp->OuterIndex)
-    {
-      ExportObjects[exp->ObjectIndex]->SetOuter(ExportObjects[exp->OuterIndex]);
-      ExportObjects[exp->OuterIndex]->AddInner(ExportObjects[exp->ObjectIndex]);
+  const int32 totalChunkCount = (size + COMPRESSED_BLOCK_SIZE - 1) / COMPRESSED_BLOCK_SIZE;
+  summary.CompressedChunks.clear();
+  summary.CompressedChunks.resize(totalChunkCount);
+  summary.PackageFlags |= PKG_StoreCompressed;
+  summary.CompressionFlags = context.Compression;
 
-      FObjectExport* outer = GetExportObject(exp->OuterIndex);
-      outer->Inner.push_back(exp);
-      exp->Outer = outer;
-    }
-    else
-    {
-      RootExports.push_back(exp);
-    }
-    CheckCancel();
-    ObjectNameToExportMap[exp->GetObjectName()].push_back(exp);
-  }
+  writeStream << summary;
 
-  for (uint32 idx = 0; idx < Summary.ImportsCount; ++idx)
+  const int32 compressedBlockSize = 2 * COMPRESSED_BLOCK_SIZE;
+  const int32 batchSize = std::max(1, SAVE_COPY_BUFFER_SIZE / COMPRESSED_BLOCK_SIZE);
+  std::vector<uint8> uncompressedData((size_t)batchSize * COMPRESSED_BLOCK_SIZE);
+  std::vector<uint8> compressedData((size_t)batchSize * compressedBlockSize);
+  std::vector<int32> compressedSizes(batchSize);
+  std::atomic_bool failed = false;
+
+  for (int32 batchStart = 0; batchStart < totalChunkCount; batchStart += batchSize)
   {
-    CheckCancel();
-    FObjectImport* imp = Imports[idx];
-#ifdef _DEBUG
-    imp->Path = imp->GetObjectPath();
-#endif
-    if (imp->OuterIndex)
+    const int32 batchEnd = std::min(totalChunkCount, batchStart + batchSize);
+    const FILE_OFFSET batchOffset = batchStart * COMPRESSED_BLOCK_SIZE;
+    readStream.SerializeBytes(uncompressedData.data(), std::min(size - batchOffset, (batchEnd - batchStart) * COMPRESSED_BLOCK_SIZE));
+    if (!readStream.IsGood())
     {
-      if (imp->OuterIndex < 0)
+      context.Error = "Failed to read source package.";
+      return false;
+    }
+
+    concurrency::parallel_for(batchStart, batchEnd, [&](int32 idx) {
+      const int32 local = idx - batchStart;
+      const int32 blockSize = std::min(COMPRESSED_BLOCK_SIZE, size - idx * COMPRESSED_BLOCK_SIZE);
+      compressedSizes[local] = compressedBlockSize;
+      if (!CompressMemory(COMPRESS_LZO, compressedData.data() + (size_t)local * compressedBlockSize, &compressedSizes[local], uncompressedData.data() + (size_t)local * COMPRESSED_BLOCK_SIZE, blockSize))
       {
-        FObjectImport* outer = GetImportObject(imp->OuterIndex);
-        outer->Inner.push_back(imp);
+        failed = true;
       }
-    }
-    else
+      FCompressedChunk& chunk = summary.CompressedChunks[idx];
+      chunk.DecompressedOffset = dataStart + idx * COMPRESSED_BLOCK_SIZE;
+      chunk.DecompressedSize = blockSize;
+    });
+
+    if (failed)
     {
-      RootImports.push_back(imp);
+      context.Error = "Failed to compress data.";
+      return false;
     }
-  }
 
-#if _DEBUG
-  for (FObjectExport* exp : Exports)
-  {
-    if (exp->ExportFlags & EF_ScriptPatcherExport)
+    for (int32 idx = batchStart; idx < batchEnd; ++idx)
     {
-      // If here: probably need to apply stack frames, patch the export table and fix net count
-      DBreak();
+      const int32 local = idx - batchStart;
+      FCompressedChunk& chunk = summary.CompressedChunks[idx];
+      chunk.CompressedOffset = writeStream.GetPosition();
+      chunk.CompressedSize = compressedSizes[local];
+      writeStream.SerializeBytes(compressedData.data() + (size_t)local * compressedBlockSize, compressedSizes[local]);
     }
   }
-#endif
 
-#if DUMP_PACKAGES
-  _DebugDump();
-#endif
+  writeStream.SetPosition(0);
+  writeStream << summary;
 
-  // Not bulletproof. Will work only for exposed packages
-  if (CompositPackageList.count(GetPackageName().ToUpper()))
+  if (!writeStream.IsGood())
   {
-    Composite = true;
+    context.Error = "IO error. Check source and destination are available for read and write!";
+    return false;
   }
+  return true;
+}
 
-  Ready.store(true);
-  Loading.store(false);
+bool CompressPackage(FStream& readStream, const std::string& destination, PackageSaveContext& context)
+{
+  FWriteStream writeStream(destination);
+  return CompressPackage(readStream, writeStream, context);
 }
 
 bool FPackage::Save(PackageSaveContext& context)
@@ -1453,7 +2280,12 @@ bool FPackage::Save(PackageSaveContext& context)
     {
       if (exp->GetClassName() == UTexture2D::StaticClassName())
       {
-        ((UTexture2D*)GetObject(exp, true))->DisableCaching();
+        UTexture2D* texture = (UTexture2D*)GetObject(exp, true);
+        if (context.KeepTextureFileCache.size() && texture->TextureFileCacheName && texture->TextureFileCacheName->String() == context.KeepTextureFileCache)
+        {
+          continue;
+        }
+        texture->DisableCaching();
       }
     }
   }
@@ -1467,88 +2299,98 @@ bool FPackage::Save(PackageSaveContext& context)
         context.ProgressDescriptionCallback("Saving...");
       }
       
-      FReadStream readStream(Summary.DataPath);
+      std::unique_ptr<FStream> readStreamPtr = CreateDataStream();
+      FStream& readStream = *readStreamPtr;
       FILE_OFFSET size = readStream.GetSize();
 
       FPackageSummary summary;
       readStream << summary;
       if (summary.CompressionFlags != context.Compression && summary.CompressedChunks.size() && summary.PackageFlags & PKG_StoreCompressed)
       {
-        FILE_OFFSET startOffset = INT_MAX;
-        FILE_OFFSET totalDecompressedSize = 0;
-
         std::vector<FCompressedChunk> chunks = summary.CompressedChunks;
-        void** compressedChunksData = new void* [chunks.size()];
+        std::sort(chunks.begin(), chunks.end(), [](const FCompressedChunk& a, const FCompressedChunk& b) {
+          return a.DecompressedOffset < b.DecompressedOffset;
+        });
 
-        for (int32 idx = 0; idx < summary.CompressedChunks.size(); ++idx)
-        {
-          FCompressedChunk& chunk = chunks[idx];
-          compressedChunksData[idx] = malloc(chunk.CompressedSize);
-          readStream.SetPosition(chunk.CompressedOffset);
-          readStream.SerializeBytes(compressedChunksData[idx], chunk.CompressedSize);
-          totalDecompressedSize += chunk.DecompressedSize;
-          if (chunk.DecompressedOffset < startOffset)
-          {
-            startOffset = chunk.DecompressedOffset;
-          }
-        }
-        
         summary.CompressedChunks.clear();
         summary.CompressionFlags = COMPRESS_None;
         summary.PackageFlags &= ~PKG_StoreCompressed;
 
-        void* decompressedPackageData = malloc(readStream.GetPosition() + totalDecompressedSize);
-
-        concurrency::parallel_for(size_t(0), size_t(chunks.size()), [&chunks, compressedChunksData, decompressedPackageData, startOffset](size_t idx) {
-          const FCompressedChunk& chunk = chunks[idx];
-          uint8* dst = (uint8*)decompressedPackageData + chunk.DecompressedOffset - startOffset;
-          LZO::Decompress(compressedChunksData[idx], chunk.CompressedSize, dst, chunk.DecompressedSize);
-        });
+        FWriteStream writeStream(context.Path);
+        writeStream << summary;
 
-        MWrightStream memStream(decompressedPackageData, readStream.GetPosition() + totalDecompressedSize);
-        memStream << summary;
+        // Decompress a batch of chunks at a time to keep memory usage bounded
+        const size_t batchSize = std::max<size_t>(1, SAVE_COPY_BUFFER_SIZE / COMPRESSED_BLOCK_SIZE);
+        std::vector<std::vector<uint8>> compressedBuffers(batchSize);
+        std::vector<std::vector<uint8>> decompressedBuffers(batchSize);
+        for (size_t batchStart = 0; batchStart < chunks.size(); batchStart += batchSize)
+        {
+          const size_t batchEnd = std::min(chunks.size(), batchStart + batchSize);
+          for (size_t idx = batchStart; idx < batchEnd; ++idx)
+          {
+            const FCompressedChunk& chunk = chunks[idx];
+            std::vector<uint8>& compressed = compressedBuffers[idx - batchStart];
+            compressed.resize(chunk.CompressedSize);
+            decompressedBuffers[idx - batchStart].resize(chunk.DecompressedSize);
+            readStream.SetPosition(chunk.CompressedOffset);
+            readStream.SerializeBytes(compressed.data(), chunk.CompressedSize);
+          }
+          if (!readStream.IsGood())
+          {
+            context.Error = "Failed to read source package.";
+            return false;
+          }
 
-        FWriteStream writeStream(context.Path);
-        writeStream.SerializeBytes(memStream.GetAllocation(), memStream.GetSize());
+          concurrency::parallel_for(batchStart, batchEnd, [&](size_t idx) {
+            const FCompressedChunk& chunk = chunks[idx];
+            LZO::Decompress(compressedBuffers[idx - batchStart].data(), chunk.CompressedSize, decompressedBuffers[idx - batchStart].data(), chunk.DecompressedSize);
+          });
 
-        free(decompressedPackageData);
+          for (size_t idx = batchStart; idx < batchEnd; ++idx)
+          {
+            const FCompressedChunk& chunk = chunks[idx];
+            writeStream.SetPosition(chunk.DecompressedOffset);
+            writeStream.SerializeBytes(decompressedBuffers[idx - batchStart].data(), chunk.DecompressedSize);
+          }
+          if (!writeStream.IsGood())
+          {
+            context.Error = "Failed to write the data.";
+            return false;
+          }
+          if (context.ProgressCallback)
+          {
+            context.ProgressCallback(int(batchEnd * 100 / chunks.size()));
+          }
+        }
         return true;
       }
 
       // Package is already decompressed. Copy the data.
 
-      void* tmp = malloc(size);
       readStream.SetPosition(0);
-      readStream.SerializeBytes(tmp, size);
       if (!readStream.IsGood() || !size)
       {
         context.Error = "Failed to read source package.";
-        free(tmp);
         return false;
       }
-      if (context.ProgressCallback)
-      {
-        context.ProgressCallback(50);
-      }
       if (context.ProgressDescriptionCallback)
       {
         context.ProgressDescriptionCallback("Writing data...");
       }
       FWriteStream writeStream(context.Path);
-      writeStream.SerializeBytes(tmp, size);
-      if (!writeStream.IsGood())
+      std::vector<uint8> buffer;
+      if (!CopyStreamData(readStream, writeStream, size, buffer))
       {
-        context.Error = "Failed to write the data.";
-        free(tmp);
+        context.Error = readStream.IsGood() ? "Failed to write the data." : "Failed to read source package.";
         return false;
       }
-      free(tmp);
       return true;
     }
 
     // Compress the package without fancy object serialization
 
-    FReadStream readStream(Summary.DataPath);
+    std::unique_ptr<FStream> readStreamPtr = CreateDataStream();
+    FStream& readStream = *readStreamPtr;
     if (!readStream.IsGood() || !readStream.GetSize())
     {
       context.Error = "Failed to read source package.";
@@ -1568,12 +2410,8 @@ bool FPackage::Save(PackageSaveContext& context)
       FWriteStream writeStream(context.Path);
       writeStream << summary;
 
-      void* pkgData = malloc(size);
-      readStream.SerializeBytes(pkgData, size);
-      writeStream.SerializeBytes(pkgData, size);
-      free(pkgData);
-
-      if (!writeStream.IsGood() || !readStream.IsGood())
+      std::vector<uint8> buffer;
+      if (!CopyStreamData(readStream, writeStream, size, buffer))
       {
         context.Error = "IO error. Check source and destination are available for read and write!";
         return false;
@@ -1581,64 +2419,29 @@ bool FPackage::Save(PackageSaveContext& context)
       return true;
     }
 
-    void* uncompressedData = malloc(size);
-    readStream.SerializeBytes(uncompressedData, size);
-
-    int32	totalChunkCount = (size + COMPRESSED_BLOCK_SIZE - 1) / COMPRESSED_BLOCK_SIZE;
-    summary.CompressedChunks.resize(totalChunkCount);
-    summary.PackageFlags |= PKG_StoreCompressed;
-    summary.CompressionFlags = context.Compression;
-
-    FWriteStream writeStream(context.Path);
-    writeStream << summary;
-
-    const int32 compressedDataSize = 2 * COMPRESSED_BLOCK_SIZE;
-    void* compressedData = malloc(compressedDataSize);
-
-    int32 chunkIndex = 0;
-    int32 remainingSize = size;
-    FILE_OFFSET offset = dataStart;
+    return CompressPackage(readStream, context.Path, context);
+  }
 
-    while (remainingSize > 0)
+  // Compressed packages are serialized to a temporary file first and then chunked by CompressPackage
+  std::string writerPath = context.Path;
+  // Removes the temporary file on every exit. Declared before the writer and the reader so both are closed first.
+  struct TemporaryFile {
+    std::string Path;
+    ~TemporaryFile()
     {
-      int32 sizeToCompress = std::min(remainingSize, COMPRESSED_BLOCK_SIZE);
-      int32 compressedSize = compressedDataSize;
-
-      if (!CompressMemory(COMPRESS_LZO, compressedData, &compressedSize, (uint8*)uncompressedData + offset, sizeToCompress))
+      if (Path.size())
       {
-        context.Error = "Failed to compress data.";
-        free(compressedData);
-        free(uncompressedData);
-        return false;
+        std::error_code err;
+        std::filesystem::remove(A2W(Path), err);
       }
-
-      summary.CompressedChunks[chunkIndex].DecompressedSize = sizeToCompress;
-      summary.CompressedChunks[chunkIndex].CompressedOffset = writeStream.GetPosition();
-      summary.CompressedChunks[chunkIndex].DecompressedOffset = offset;
-      offset += sizeToCompress;
-
-      writeStream.SerializeBytes(compressedData, compressedSize);
-
-      summary.CompressedChunks[chunkIndex].CompressedSize = compressedSize;
-      chunkIndex++;
-      remainingSize -= COMPRESSED_BLOCK_SIZE;
-    }
-
-    writeStream.SetPosition(0);
-    writeStream << summary;
-
-    free(compressedData);
-    free(uncompressedData);
-
-    if (!writeStream.IsGood() || !readStream.IsGood())
-    {
-      context.Error = "IO error. Check source and destination are available for read and write!";
-      return false;
     }
-    return true;
+  } temporaryFile;
+  if (context.Compression != COMPRESS_None)
+  {
+    writerPath = W2A((std::filesystem::temp_directory_path() / std::tmpnam(nullptr)).wstring());
+    temporaryFile.Path = writerPath;
   }
-
-  FWriteStream writer(context.Path);
+  FWriteStream writer(writerPath);
   if (!writer.IsGood())
   {
     context.Error = "Failed to write data!";
@@ -1647,8 +2450,8 @@ bool FPackage::Save(PackageSaveContext& context)
   writer.SetPackage(this);
   
   // Stream of the decompressed temporary source.
-  FReadStream reader(Summary.DataPath); // TODO: we may have no data path for a new packages.
-  reader.SetPackage(this);
+  std::unique_ptr<FStream> readerPtr = CreateDataStream(); // TODO: we may have no data for a new packages.
+  FStream& reader = *readerPtr;
   if (!reader.IsGood())
   {
     context.Error = "Failed to read the source package!";
@@ -1765,15 +2568,9 @@ bool FPackage::Save(PackageSaveContext& context)
   }
 
   FILE_OFFSET exportsStart = sortedExports.front()->SerialOffset;
-  auto appendZeroed = [](FStream& s, FILE_OFFSET size) {
-    void* tmp = calloc(size, 1);
-    s.SerializeBytes(tmp, size);
-    free(tmp);
-  };
-
   if (exportsStart > writer.GetPosition())
   {
-    appendZeroed(writer, exportsStart - writer.GetPosition());
+    AppendZeroed(writer, exportsStart - writer.GetPosition());
   }
   else if (exportsStart < writer.GetPosition())
   {
@@ -1790,6 +2587,17 @@ bool FPackage::Save(PackageSaveContext& context)
   {
     context.ProgressCallback(0);
   }
+  if (context.FullRecook)
+  {
+    if (context.ProgressDescriptionCallback)
+    {
+      context.ProgressDescriptionCallback("Loading objects...");
+    }
+    if (!LoadAllExports())
+    {
+      LogW("%s: Some of the objects failed to load", GetPackageName().C_str());
+    }
+  }
   if (context.ProgressDescriptionCallback)
   {
     context.ProgressDescriptionCallback("Serializing objects...");
@@ -1797,15 +2605,37 @@ bool FPackage::Save(PackageSaveContext& context)
 
   // List of holes left after moving dirty objects. Offset, Size.
   std::vector<std::pair<FILE_OFFSET, FILE_OFFSET>> holes;
+
+  // Runs of untouched exports that are contiguous in the source are copied as a single range.
+  // Source offset and size of the pending range. Nothing is written until the run breaks.
+  FILE_OFFSET copyOffset = 0;
+  FILE_OFFSET copySize = 0;
+  std::vector<uint8> copyBuffer;
+  auto flushCopy = [&] {
+    if (!copySize)
+    {
+      return true;
+    }
+    reader.SetPosition(copyOffset);
+    bool result = CopyStreamData(reader, writer, copySize, copyBuffer);
+    copySize = 0;
+    return result;
+  };
+
   int32 idx = 0;
   for (FObjectExport* exp : sortedExports)
   {
     if (exp->ObjectFlags & RF_Marked)
     {
+      if (!flushCopy())
+      {
+        context.Error = "IO error. Check source and destination are available for read and write!";
+        return false;
+      }
       if (context.PreserveOffsets)
       {
         holes.push_back({ writer.GetPosition(), exp->SerialSize });
-        appendZeroed(writer, exp->SerialSize);
+        AppendZeroed(writer, exp->SerialSize);
       }
       else
       {
@@ -1817,12 +2647,17 @@ bool FPackage::Save(PackageSaveContext& context)
     }
     else
     {
-      if (context.PreserveOffsets && writer.GetPosition() != exp->SerialOffset)
+      if (context.PreserveOffsets && writer.GetPosition() + copySize != exp->SerialOffset)
       {
+        if (!flushCopy())
+        {
+          context.Error = "IO error. Check source and destination are available for read and write!";
+          return false;
+        }
         if (writer.GetPosition() < exp->SerialOffset)
         {
           holes.push_back({ writer.GetPosition(), exp->SerialOffset - writer.GetPosition() });
-          appendZeroed(writer, exp->SerialOffset - writer.GetPosition());
+          AppendZeroed(writer, exp->SerialOffset - writer.GetPosition());
         }
         else
         {
@@ -1832,12 +2667,17 @@ bool FPackage::Save(PackageSaveContext& context)
       }
       if (!context.FullRecook)
       {
-        reader.SetPosition(exp->SerialOffset);
-        void* data = malloc(exp->SerialSize);
-        reader.SerializeBytes(data, exp->SerialSize);
-        exp->SerialOffset = writer.GetPosition();
-        writer.SerializeBytes(data, exp->SerialSize);
-        free(data);
+        if (copySize && copyOffset + copySize != exp->SerialOffset && !flushCopy())
+        {
+          context.Error = "IO error. Check source and destination are available for read and write!";
+          return false;
+        }
+        if (!copySize)
+        {
+          copyOffset = exp->SerialOffset;
+        }
+        exp->SerialOffset = writer.GetPosition() + copySize;
+        copySize += exp->SerialSize;
       }
       else
       {
@@ -1847,6 +2687,11 @@ bool FPackage::Save(PackageSaveContext& context)
         {
           obj->Load();
         }
+        if (obj->GetLoadState() == ObjectLoadState::Failed)
+        {
+          context.Error = "Failed to load " + obj->GetFullObjectName().UTF8();
+          return false;
+        }
         obj->Serialize(writer);
         exp->SerialSize = writer.GetPosition() - exp->SerialOffset;
       }
@@ -1857,6 +2702,12 @@ bool FPackage::Save(PackageSaveContext& context)
     }
   }
 
+  if (!flushCopy())
+  {
+    context.Error = "IO error. Check source and destination are available for read and write!";
+    return false;
+  }
+
   if (moveTables)
   {
     Summary.ImportsOffset = writer.GetPosition();
@@ -1965,6 +2816,19 @@ bool FPackage::Save(PackageSaveContext& context)
   {
     context.Error = "Unknown error! Failed to write data!";
   }
+  if (context.Compression != COMPRESS_None)
+  {
+    writer.Close();
+    if (isOk)
+    {
+      if (context.ProgressDescriptionCallback)
+      {
+        context.ProgressDescriptionCallback("Compressing...");
+      }
+      FReadStream uncompressed(writerPath);
+      isOk = CompressPackage(uncompressed, context.Path, context);
+    }
+  }
   return isOk;
 }
 
@@ -2040,6 +2904,16 @@ UObject* FPackage::GetObject(FObjectImport* imp, bool load)
 
     if (impPkgName != GetPackageName(false))
     {
+      // Another package may have resolved the same import already
+      const FString resolvedKey = imp->GetFullObjectName();
+      if (UObject* obj = FindResolvedImport(resolvedKey))
+      {
+        if (load)
+        {
+          obj->Load();
+        }
+        return SetCachedImportObject(imp->ObjectIndex, obj);
+      }
       // Check already loaded packages
       {
         std::scoped_lock<std::mutex> lock(ExternalPackagesMutex);
@@ -2048,8 +2922,11 @@ UObject* FPackage::GetObject(FObjectImport* imp, bool load)
           if (impPkgName == external->GetPackageName(false))
           {
             UObject* obj = external->GetObject(imp, load);
-            ImportObjects[imp->ObjectIndex] = obj;
-            return obj;
+            if (obj)
+            {
+              AddResolvedImport(resolvedKey, external, obj);
+            }
+            return SetCachedImportObject(imp->ObjectIndex, obj);
           }
         }
       }
@@ -2059,10 +2936,12 @@ UObject* FPackage::GetObject(FObjectImport* imp, bool load)
         package->Load();
         if (UObject* obj = package->GetObject(imp, load))
         {
-          std::scoped_lock<std::mutex> lock(ExternalPackagesMutex);
-          ExternalPackages.emplace_back(package);
-          ImportObjects[imp->ObjectIndex] = obj;
-          return obj;
+          AddResolvedImport(resolvedKey, package, obj);
+          {
+            std::scoped_lock<std::mutex> lock(ExternalPackagesMutex);
+            ExternalPackages.emplace_back(package);
+          }
+          return SetCachedImportObject(imp->ObjectIndex, obj);
         }
         UnloadPackage(package);
       }
@@ -2424,6 +3303,7 @@ PACKAGE_INDEX FPackage::ImportClass(UClass* cls)
     }
     classPackageImport->ObjectIndex = -PACKAGE_INDEX(Imports.size()) - 1;
     Imports.push_back(classPackageImport);
+    InvalidatePathIndex();
     MarkDirty();
   }
 
@@ -2432,6 +3312,7 @@ PACKAGE_INDEX FPackage::ImportClass(UClass* cls)
   {
     classImport->ObjectIndex = -PACKAGE_INDEX(Imports.size()) - 1;
     Imports.push_back(classImport);
+    InvalidatePathIndex();
     MarkDirty();
     return classImport->ObjectIndex;
   }
@@ -2480,9 +3361,10 @@ UObject* FPackage::GetObject(NET_INDEX netIndex, const FString& name, const FStr
 
 std::vector<FObjectExport*> FPackage::GetExportObject(const FString& name)
 {
-  if (ObjectNameToExportMap.count(name))
+  auto it = ObjectNameToExportMap.find(name);
+  if (it != ObjectNameToExportMap.end())
   {
-    return ObjectNameToExportMap[name];
+    return it->second;
   }
   for (VObjectExport* vexp : VExports)
   {
@@ -2508,7 +3390,14 @@ void FPackage::MarkDirty(bool dirty)
 
 FObjectImport* FPackage::GetImportObject(const FString& objectName, const FString& className) const
 {
-  for (FObjectImport* imp : Imports)
+  std::scoped_lock<std::mutex> lock(PathIndexMutex);
+  BuildPathIndex();
+  auto it = ImportNameIndex.find(objectName);
+  if (it == ImportNameIndex.end())
+  {
+    return nullptr;
+  }
+  for (FObjectImport* imp : it->second)
   {
     if (imp->GetObjectName() == objectName && imp->GetClassName() == className)
     {
@@ -2518,6 +3407,107 @@ FObjectImport* FPackage::GetImportObject(const FString& objectName, const FStrin
   return nullptr;
 }
 
+FObjectExport* FPackage::FindExportByPath(const FString& path) const
+{
+  std::scoped_lock<std::mutex> lock(PathIndexMutex);
+  BuildPathIndex();
+  auto it = ExportPathIndex.find(path);
+  if (it != ExportPathIndex.end())
+  {
+    return it->second;
+  }
+  // Strip the package name
+  const size_t pos = path.Find('.');
+  if (pos != std::string::npos && FStringEqualIgnoreCase()(path.Substr(0, pos).UTF8(), GetPackageName().UTF8()))
+  {
+    it = ExportPathIndex.find(path.Substr(pos + 1));
+    if (it != ExportPathIndex.end())
+    {
+      return it->second;
+    }
+  }
+  return nullptr;
+}
+
+FObjectImport* FPackage::FindImportByPath(const FString& path) const
+{
+  std::scoped_lock<std::mutex> lock(PathIndexMutex);
+  BuildPathIndex();
+  auto it = ImportPathIndex.find(path);
+  return it != ImportPathIndex.end() ? it->second : nullptr;
+}
+
+void FPackage::BuildPathIndex() const
+{
+  if (PathIndexReady)
+  {
+    return;
+  }
+  ExportPathIndex.clear();
+  ImportPathIndex.clear();
+  ImportNameIndex.clear();
+
+  // A path is the outer's path plus the object name, so every name is appended once.
+  // Outers may follow their inners in the tables: walk up the chain until a known path is found.
+  // Broken tables may have outer cycles. A chain stops at an object it already contains.
+  std::vector<FString> exportPaths(Exports.size());
+  std::vector<PACKAGE_INDEX> chain;
+  std::vector<bool> inChain(std::max(Exports.size(), Imports.size()));
+  for (FObjectExport* exp : Exports)
+  {
+    for (FObjectExport* item = exp; item && exportPaths[item->ObjectIndex - 1].Empty() && !inChain[item->ObjectIndex - 1]; item = item->OuterIndex > 0 ? Exports[item->OuterIndex - 1] : nullptr)
+    {
+      inChain[item->ObjectIndex - 1] = true;
+      chain.push_back(item->ObjectIndex);
+    }
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+    {
+      FObjectExport* item = Exports[*it - 1];
+      const bool hasOuterPath = item->OuterIndex > 0 && exportPaths[item->OuterIndex - 1].Size();
+      exportPaths[*it - 1] = hasOuterPath ? exportPaths[item->OuterIndex - 1] + "." + item->GetObjectName() : item->GetObjectName();
+      inChain[*it - 1] = false;
+    }
+    chain.clear();
+    // Names are unique within an outer. Keep the first one if the package is malformed
+    ExportPathIndex.emplace(exportPaths[exp->ObjectIndex - 1], exp);
+  }
+
+  std::vector<FString> importPaths(Imports.size());
+  for (FObjectImport* imp : Imports)
+  {
+    for (FObjectImport* item = imp; item && importPaths[-item->ObjectIndex - 1].Empty() && !inChain[-item->ObjectIndex - 1]; item = item->OuterIndex < 0 ? Imports[-item->OuterIndex - 1] : nullptr)
+    {
+      inChain[-item->ObjectIndex - 1] = true;
+      chain.push_back(item->ObjectIndex);
+    }
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+    {
+      FObjectImport* item = Imports[-*it - 1];
+      if (item->OuterIndex < 0)
+      {
+        const FString& outerPath = importPaths[-item->OuterIndex - 1];
+        importPaths[-*it - 1] = outerPath.Size() ? outerPath + "." + item->GetObjectName() : item->GetObjectName();
+      }
+      else
+      {
+        // Imports inside exports are rare. Let the import build its own path
+        importPaths[-*it - 1] = item->GetObjectPath();
+      }
+      inChain[-*it - 1] = false;
+    }
+    chain.clear();
+    ImportPathIndex.emplace(importPaths[-imp->ObjectIndex - 1], imp);
+    ImportNameIndex[imp->GetObjectName()].push_back(imp);
+  }
+  PathIndexReady = true;
+}
+
+void FPackage::InvalidatePathIndex()
+{
+  std::scoped_lock<std::mutex> lock(PathIndexMutex);
+  PathIndexReady = false;
+}
+
 bool FPackage::AddImport(UObject* object, FObjectImport*& output)
 {
   if (!object || !object->GetPackage() || object->GetPackage() == this)
@@ -2562,6 +3552,7 @@ bool FPackage::AddImport(UObject* object, FObjectImport*& output)
     importObject->ClassPackage.SetString("Core");
     importObject->OuterIndex = 0;
     Imports.push_back(importObject);
+    InvalidatePathIndex();
     importObject->ObjectIndex = -(PACKAGE_INDEX)Imports.size();
     RootImports.push_back(importObject);
     outerPackage = importObject;
@@ -2608,6 +3599,7 @@ bool FPackage::AddImport(UObject* object, FObjectImport*& output)
   }
 
   Imports.push_back(importObject);
+  InvalidatePathIndex();
   importObject->ObjectIndex = -(PACKAGE_INDEX)Imports.size();
   output = importObject;
   ImportObjects[importObject->ObjectIndex] = object;
@@ -2632,7 +3624,7 @@ void FPackage::ConvertObjectToRedirector(UObject*& source, UObject* targer)
 
   source = ExportObjects[exp->ObjectIndex];
   UObjectRedirector* redirector = (UObjectRedirector*)source;
-  redirector->Loaded = true;
+  redirector->LoadState = ObjectLoadState::Loaded;
 
   imp = nullptr;
   AddImport(targer, imp);
@@ -2654,6 +3646,73 @@ void FPackage::RetainPackage(std::shared_ptr<FPackage> package)
   ExternalPackages.push_back(package);
 }
 
+UObject* FPackage::FindResolvedImport(const FString& key)
+{
+  std::shared_ptr<FPackage> package;
+  UObject* obj = nullptr;
+  {
+    std::scoped_lock<std::mutex> l(ResolvedImportsMutex);
+    auto it = ResolvedImports.find(key);
+    if (it == ResolvedImports.end())
+    {
+      return nullptr;
+    }
+    package = it->second.Package.lock();
+    obj = it->second.Object;
+  }
+  if (!package || package.get() == this)
+  {
+    return nullptr;
+  }
+  {
+    std::scoped_lock<std::mutex> l(ExternalPackagesMutex);
+    if (std::find(ExternalPackages.begin(), ExternalPackages.end(), package) != ExternalPackages.end())
+    {
+      return obj;
+    }
+  }
+  // Every external package must be retained once. UnloadPackage releases it in the destructor
+  {
+    std::scoped_lock<std::recursive_mutex> l(PackagesMutex);
+    LoadedPackages.push_back(package);
+  }
+  RetainPackage(package);
+  return obj;
+}
+
+void FPackage::AddResolvedImport(const FString& key, const std::shared_ptr<FPackage>& package, UObject* obj)
+{
+  std::scoped_lock<std::mutex> l(ResolvedImportsMutex);
+  auto result = ResolvedImports.emplace(key, FResolvedImport());
+  if (!result.second && !result.first->second.Package.expired())
+  {
+    return;
+  }
+  result.first->second.Object = obj;
+  result.first->second.Package = package;
+  ResolvedImportKeys[package.get()].push_back(key);
+}
+
+void FPackage::ForgetResolvedImports(FPackage* package)
+{
+  std::scoped_lock<std::mutex> l(ResolvedImportsMutex);
+  auto it = ResolvedImportKeys.find(package);
+  if (it == ResolvedImportKeys.end())
+  {
+    return;
+  }
+  for (const FString& key : it->second)
+  {
+    auto entry = ResolvedImports.find(key);
+    // The key may have been taken over by another package after this one expired
+    if (entry != ResolvedImports.end() && entry->second.Package.expired())
+    {
+      ResolvedImports.erase(entry);
+    }
+  }
+  ResolvedImportKeys.erase(it);
+}
+
 void FPackage::_DebugDump() const
 {
 #if DUMP_PACKAGES
@@ -2663,10 +3722,9 @@ void FPackage::_DebugDump() const
   std::ofstream ds(path.wstring());
   ds << "SourcePath: \"" << Summary.SourcePath.UTF8() << "\"\n";
   ds << "DataPath: \"" << Summary.DataPath.UTF8() << "\"\n";
-  if (GetFileVersion() > VER_TERA_CLASSIC && CompositeDataPath.Size())
+  if (GetFileVersion() > VER_TERA_CLASSIC && CompositeSourcePath.Size())
   {
     ds << "CompositeSourcePath: \"" << CompositeSourcePath.UTF8() << "\"\n";
-    ds << "CompositeDataPath: \"" << CompositeDataPath.UTF8() << "\"\n";
   }
   ds << "Version: " << Summary.FileVersion << "/" << Summary.LicenseeVersion << std::endl;
   ds << "HeaderSize: " << Summary.HeaderSize << std::endl;
@@ -17,6 +17,8 @@ struct PackageSaveContext {
 	bool EmbedObjectPath = true;
 	bool PreserveOffsets = true;
 	bool DisableTextureCaching = true;
+	// Name of a texture file cache made for this save. DisableTextureCaching keeps textures that point to it.
+	std::string KeepTextureFileCache;
 	bool FullRecook = false;
 
 	std::string Error;
@@ -27,6 +29,16 @@ struct PackageSaveContext {
 	std::function<bool(void)> IsCancelledCallback;
 };
 
+// A package stored in a composite mod
+struct FCompositeModEntry {
+	FString Path;
+	FString ObjectPath;
+	FILE_OFFSET Offset = 0;
+	FILE_OFFSET Size = 0;
+	// FNV-1a hash of the stored data
+	uint64 Hash = 0;
+};
+
 class FPackage {
 public:
 
@@ -46,6 +58,9 @@ public:
 	static void LoadObjectRedirectorMapper(bool rebuild = false);
 	// Load and retain a package at the path. Every GetPackage call must pair a UnloadPackage call
 	static std::shared_ptr<FPackage> GetPackage(const FString& path);
+	// Load and retain a package from a memory buffer. Compressed packages are decompressed to memory.
+	// path is used as an identifier only. Every GetPackageFromMemory call must pair a UnloadPackage call
+	static std::shared_ptr<FPackage> GetPackageFromMemory(std::shared_ptr<uint8> data, FILE_OFFSET size, const FString& path);
 	// Load and retain a package by name and guid(if valid). Every GetPackageNamed call must pair a UnloadPackage call
 	static std::shared_ptr<FPackage> GetPackageNamed(const FString& name, FGuid guid = FGuid());
 	// Release a package. 
@@ -59,17 +74,18 @@ public:
 	// Get texture file cache path with name
 	static FString GetTextureFileCachePath(const FString& tfcName);
 	// Get composite map
-	static const std::unordered_map<FString, FCompositePackageMapEntry>& GetCompositePackageMap();
+	static const FStringMap<FCompositePackageMapEntry>& GetCompositePackageMap();
 	// Get list of all composite packages
-	static const std::unordered_map<FString, std::vector<FString>>& GetCompositePackageList();
+	static const FStringMap<std::vector<FString>>& GetCompositePackageList();
 	// Get composite package map .dat path
 	static FString GetCompositePackageMapPath();
 	// Get composite package name for an object path
 	static FString GetObjectCompositePath(const FString& path);
 	// Update DirCache
 	static void UpdateDirCache();
-	// Create a composite mod package
-	static void CreateCompositeMod(const std::vector<FString>& items, const FString& destination, FString name, FString author);
+	// Create a composite mod package. Packages are validated, compressed(optional) and hashed in parallel.
+	// Returns entries in the order of items.
+	static std::vector<FCompositeModEntry> CreateCompositeMod(const std::vector<FString>& items, const FString& destination, FString name, FString author, bool compress = false);
 	// Get all classes
 	static std::vector<UClass*> GetClasses();
 	// Register a built-in class
@@ -84,9 +100,18 @@ private:
 public:
 	~FPackage();
 
-	// Create a read stream using DataPath and serialize tables
+	// Create a read stream using DataPath and serialize tables.
+	// Thread safe. Concurrent callers block until the first call finishes
 	void Load();
 
+	// Load all exports on up to parallelism threads (0 - all cores). Outers and classes are loaded before objects that depend on them.
+	// Returns false if any of the objects failed to load.
+	bool LoadAllExports(int32 parallelism = 0);
+
+	// Load exports on up to parallelism threads. Exports are read in large sequential ranges sorted by offset
+	// and deserialized from memory. Returns false if any of the objects failed to load.
+	bool LoadExports(std::vector<FObjectExport*> exports, int32 parallelism = 0);
+
 	bool Save(PackageSaveContext& options);
 
 	// Get an object at index
@@ -170,6 +195,12 @@ public:
 
 	FObjectImport* GetImportObject(const FString& objectName, const FString& className) const;
 
+	// Find an export by its path. Case-insensitive. The package name is optional: "Package.Outer.Object" or "Outer.Object"
+	FObjectExport* FindExportByPath(const FString& path) const;
+
+	// Find an import by its path. Case-insensitive. E.g. "Core.Object"
+	FObjectImport* FindImportByPath(const FString& path) const;
+
 	// Get export object at index
 	inline FObjectExport* GetExportObject(PACKAGE_INDEX index) const
 	{
@@ -241,6 +272,16 @@ public:
 		return Summary.DataPath;
 	}
 
+	// Create a read stream of the decompressed package data.
+	// Use it instead of opening the DataPath: in-memory packages have no data file
+	std::unique_ptr<FStream> CreateDataStream() const;
+
+	// Read data an object skipped during serialization. read is called with the stream at the offset.
+	// Returns false if the stream failed. The offset is reset to INDEX_NONE after the read.
+	// The owner must hold its data mutex and keep the result until this returns, so other threads
+	// never see the offset reset before the data is in place.
+	bool ReadDeferredData(FILE_OFFSET& offset, const std::function<void(FStream&)>& read) const;
+
 	// Returns true if Load() finished
 	inline bool IsReady() const
 	{
@@ -311,6 +352,12 @@ public:
 private:
 	void _DebugDump() const;
 
+	// Create a package from a memory buffer without adding it to LoadedPackages
+	static std::shared_ptr<FPackage> CreatePackageFromMemory(std::shared_ptr<uint8> data, FILE_OFFSET size, const FString& path);
+
+	// Load() body. Must be called with LoadMutex locked
+	void ReadTables();
+
 	UObject* GetCachedExportObject(PACKAGE_INDEX index) const;
 	UObject* GetCachedForcedObject(PACKAGE_INDEX index) const;
 	UObject* GetCachedImportObject(PACKAGE_INDEX index) const;
@@ -321,12 +368,25 @@ private:
 
 	UObject* GetForcedExport(FObjectExport* exp);
 
+	// Process-wide cache of resolved imports. Keys are full object names: "Class Package.Outer.Object"
+	// Returns a cached object and retains its package
+	UObject* FindResolvedImport(const FString& key);
+	static void AddResolvedImport(const FString& key, const std::shared_ptr<FPackage>& package, UObject* obj);
+	// Drop imports resolved to the package
+	static void ForgetResolvedImports(FPackage* package);
+
+	// Must be called with PathIndexMutex locked
+	void BuildPathIndex() const;
+	void InvalidatePathIndex();
+
 private:
 	FPackageSummary Summary;
 	FStream* Stream = nullptr;
 
-	// Prevent multiple Load() calls
-	std::atomic_bool Loading = { false };
+	// Serializes Load() calls
+	std::mutex LoadMutex;
+	// Load threw. Don't read the tables again
+	std::atomic_bool LoadFailed = { false };
 	// Load finished 
 	std::atomic_bool Ready = { false };
 	// Load was cancelled
@@ -358,13 +418,22 @@ private:
 	std::vector<FObjectExport*> RootExports;
 	std::vector<FObjectImport*> RootImports;
 
-	FString CompositeDataPath;
 	FString CompositeSourcePath;
 
+	// Decompressed package data of in-memory packages
+	std::shared_ptr<uint8> DataBuffer;
+	FILE_OFFSET DataBufferSize = 0;
+
 	// Cached netIndices for faster netIndex lookup. Containes only loaded objects!
 	std::map<NET_INDEX, UObject*> NetIndexMap;
 	// Name to Object map for faster import lookup
-	std::unordered_map<FString, std::vector<FObjectExport*>> ObjectNameToExportMap;
+	FStringMap<std::vector<FObjectExport*>> ObjectNameToExportMap;
+	// Path lookup tables. Built on the first lookup and dropped when imports change
+	mutable std::mutex PathIndexMutex;
+	mutable bool PathIndexReady = false;
+	mutable FStringMap<FObjectExport*> ExportPathIndex;
+	mutable FStringMap<FObjectImport*> ImportPathIndex;
+	mutable FStringMap<std::vector<FObjectImport*>> ImportNameIndex;
 	// List of packages we rely on
 	std::mutex ExternalPackagesMutex;
 	std::vector<std::shared_ptr<FPackage>> ExternalPackages;
@@ -375,18 +444,27 @@ private:
 	static std::vector<std::shared_ptr<FPackage>> DefaultClassPackages;
 	static std::vector<FString> DirCache;
 	static std::unordered_map<FString, FString> TfcCache;
-	static std::unordered_map<FString, FString> PkgMap;
+	static FStringMap<FString> PkgMap;
 	static std::unordered_map<FString, FString> ObjectRedirectorMap;
-	static std::unordered_map<FString, FCompositePackageMapEntry> CompositPackageMap;
-	static std::unordered_map<FString, std::vector<FString>> CompositPackageList;
-	static std::unordered_map<FString, FBulkDataInfo> BulkDataMap;
-	static std::unordered_map<FString, FTextureFileCacheInfo> TextureCacheMap;
+	static FStringMap<FCompositePackageMapEntry> CompositPackageMap;
+	static FStringMap<std::vector<FString>> CompositPackageList;
+	static FStringMap<FBulkDataInfo> BulkDataMap;
+	static FStringMap<FTextureFileCacheInfo> TextureCacheMap;
 	static std::unordered_map<FString, std::unordered_map<FString, AMetaDataEntry>> MetaData;
 	static std::mutex ClassMapMutex;
-	static std::unordered_map<FString, UObject*> ClassMap;
+	static FStringMap<UObject*> ClassMap;
 	static std::unordered_set<FString> MissingClasses;
 	static std::mutex MissingPackagesMutex;
 	static std::vector<FString> MissingPackages;
 
+	struct FResolvedImport {
+		UObject* Object = nullptr;
+		// Package that keeps the object alive
+		std::weak_ptr<FPackage> Package;
+	};
+	static std::mutex ResolvedImportsMutex;
+	static FStringMap<FResolvedImport> ResolvedImports;
+	static std::unordered_map<FPackage*, std::vector<FString>> ResolvedImportKeys;
+
 	static uint16 CoreVersion;
 };
\ No newline at end of file
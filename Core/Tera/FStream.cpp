@@ -2,8 +2,16 @@
 #include "FPackage.h"
 #include "UObject.h"
 
+#include <atomic>
 #include <ppl.h>
 
+// File streams use Win32 handles directly. Keep GDI and USER macros (GetObject, GetClassName) out of the code
+#define NOMINMAX
+#define NOGDI
+#define NOUSER
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
 FStream& FStream::operator<<(FString& s)
 {
   if (IsReading())
@@ -18,11 +26,11 @@ FStream& FStream::operator<<(FString& s)
     }
     else if (len < 0)
     {
-      std::wstring wstr;
+      // Names and paths are read in bulk. Reuse the buffer and decode directly to the string
+      thread_local std::wstring wstr;
       wstr.resize(-len);
-      len = -len * 2;
-      SerializeBytes(&wstr[0], len);
-      s += W2A(wstr);
+      SerializeBytes(&wstr[0], -len * 2);
+      s.AssignUTF16(wstr.c_str(), wstr.size());
     }
   }
   else
@@ -54,6 +62,276 @@ uint16 FStream::GetLV() const
   return Package ? Package->GetLicenseeVersion() : 0;
 }
 
+namespace
+{
+  std::atomic<size_t> FileBufferSize = { 256 * 1024 };
+
+  HANDLE OpenFileHandle(const FString& path, DWORD access, DWORD disposition, DWORD flags)
+  {
+    HANDLE handle = CreateFileW(path.WString().c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, disposition, flags, nullptr);
+    return handle == INVALID_HANDLE_VALUE ? nullptr : handle;
+  }
+
+  FILE_OFFSET GetFileHandleSize(HANDLE handle)
+  {
+    LARGE_INTEGER size = {};
+    return GetFileSizeEx(handle, &size) ? (FILE_OFFSET)size.QuadPart : 0;
+  }
+}
+
+void FStream::SetFileBufferSize(size_t size)
+{
+  FileBufferSize = std::max<size_t>(size, 4096);
+}
+
+size_t FStream::GetFileBufferSize()
+{
+  return FileBufferSize;
+}
+
+FReadStream::FReadStream(const FString& path)
+  : FStream()
+  , Path(path)
+{
+  Reading = true;
+  Handle = OpenFileHandle(Path, GENERIC_READ, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN);
+  if ((Good = Handle != nullptr))
+  {
+    FileSize = GetFileHandleSize(Handle);
+    Buffer.resize(GetFileBufferSize());
+  }
+  InlineCursor = InlineEnd = Buffer.data();
+}
+
+FReadStream::FReadStream(FReadStream* s)
+  : FReadStream(s->Path)
+{
+  SetPosition(s->GetPosition());
+}
+
+FReadStream::~FReadStream()
+{
+  Close();
+}
+
+size_t FReadStream::ReadAt(void* ptr, FILE_OFFSET offset, size_t size)
+{
+  size_t total = 0;
+  while (Handle && total < size)
+  {
+    // Positional read. Doesn't depend on the file pointer, so the buffer stays valid
+    OVERLAPPED overlapped = {};
+    const uint64 position = (uint64)offset + total;
+    overlapped.Offset = (DWORD)position;
+    overlapped.OffsetHigh = (DWORD)(position >> 32);
+    DWORD read = 0;
+    if (!ReadFile(Handle, (uint8*)ptr + total, (DWORD)(size - total), &read, &overlapped) || !read)
+    {
+      break;
+    }
+    total += read;
+  }
+  return total;
+}
+
+void FReadStream::SerializeBytes(void* ptr, FILE_OFFSET size)
+{
+  if (!ptr || size <= 0 || !Good)
+  {
+    return;
+  }
+  uint8* dst = (uint8*)ptr;
+  const FILE_OFFSET available = (FILE_OFFSET)(InlineEnd - InlineCursor);
+  if (available >= size)
+  {
+    memcpy(dst, InlineCursor, size);
+    InlineCursor += size;
+    return;
+  }
+  memcpy(dst, InlineCursor, available);
+  InlineCursor += available;
+  dst += available;
+  size -= available;
+
+  const FILE_OFFSET position = GetPosition();
+  if ((size_t)size >= Buffer.size())
+  {
+    // Large reads go straight to the destination
+    const size_t read = ReadAt(dst, position, size);
+    BufferOffset = position + (FILE_OFFSET)read;
+    InlineCursor = InlineEnd = Buffer.data();
+    Good = read == (size_t)size;
+    return;
+  }
+
+  const size_t read = ReadAt(Buffer.data(), position, Buffer.size());
+  BufferOffset = position;
+  InlineCursor = Buffer.data();
+  InlineEnd = Buffer.data() + read;
+  if (read < (size_t)size)
+  {
+    memcpy(dst, InlineCursor, read);
+    InlineCursor += read;
+    Good = false;
+    return;
+  }
+  memcpy(dst, InlineCursor, size);
+  InlineCursor += size;
+}
+
+void FReadStream::SerializeBytesAt(void* ptr, FILE_OFFSET offset, FILE_OFFSET size)
+{
+  if (!ptr || size <= 0 || !Good)
+  {
+    return;
+  }
+  if (ReadAt(ptr, offset, size) != (size_t)size)
+  {
+    Good = false;
+  }
+}
+
+void FReadStream::SetPosition(FILE_OFFSET pos)
+{
+  // Keep the buffer if the position is inside of it
+  if (pos >= BufferOffset && pos <= BufferOffset + (FILE_OFFSET)(InlineEnd - Buffer.data()))
+  {
+    InlineCursor = Buffer.data() + (pos - BufferOffset);
+    return;
+  }
+  BufferOffset = pos;
+  InlineCursor = InlineEnd = Buffer.data();
+}
+
+void FReadStream::Close()
+{
+  if (Handle)
+  {
+    CloseHandle(Handle);
+    Handle = nullptr;
+  }
+  Good = false;
+  InlineCursor = InlineEnd = Buffer.data();
+}
+
+FWriteStream::FWriteStream(const FString& path, bool trunk)
+  : FStream()
+  , Path(path)
+{
+  Reading = false;
+  Handle = OpenFileHandle(Path, GENERIC_READ | GENERIC_WRITE, trunk ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL);
+  if ((Good = Handle != nullptr))
+  {
+    FileSize = trunk ? 0 : GetFileHandleSize(Handle);
+    Buffer.resize(GetFileBufferSize());
+  }
+  InlineCursor = Buffer.data();
+  InlineEnd = Buffer.data() + Buffer.size();
+}
+
+FWriteStream::~FWriteStream()
+{
+  Close();
+}
+
+bool FWriteStream::WriteAt(const void* ptr, FILE_OFFSET offset, size_t size)
+{
+  size_t total = 0;
+  while (Handle && total < size)
+  {
+    OVERLAPPED overlapped = {};
+    const uint64 position = (uint64)offset + total;
+    overlapped.Offset = (DWORD)position;
+    overlapped.OffsetHigh = (DWORD)(position >> 32);
+    DWORD written = 0;
+    if (!WriteFile(Handle, (const uint8*)ptr + total, (DWORD)(size - total), &written, &overlapped) || !written)
+    {
+      break;
+    }
+    total += written;
+  }
+  if (total)
+  {
+    FileSize = std::max(FileSize, offset + (FILE_OFFSET)total);
+  }
+  return total == size;
+}
+
+void FWriteStream::Flush()
+{
+  const size_t pending = InlineCursor - Buffer.data();
+  if (!pending)
+  {
+    return;
+  }
+  if (Good && !WriteAt(Buffer.data(), BufferOffset, pending))
+  {
+    Good = false;
+  }
+  BufferOffset += (FILE_OFFSET)pending;
+  InlineCursor = Buffer.data();
+}
+
+void FWriteStream::SerializeBytes(void* ptr, FILE_OFFSET size)
+{
+  if (!ptr || size <= 0 || !Good)
+  {
+    return;
+  }
+  if (InlineEnd - InlineCursor >= size)
+  {
+    memcpy(InlineCursor, ptr, size);
+    InlineCursor += size;
+    return;
+  }
+  Flush();
+  if ((size_t)size >= Buffer.size())
+  {
+    // Large writes go straight to the file
+    Good = WriteAt(ptr, BufferOffset, size) && Good;
+    BufferOffset += size;
+    return;
+  }
+  memcpy(InlineCursor, ptr, size);
+  InlineCursor += size;
+}
+
+void FWriteStream::SerializeBytesAt(void* ptr, FILE_OFFSET offset, FILE_OFFSET size)
+{
+  if (!ptr || size <= 0 || !Good)
+  {
+    return;
+  }
+  // The range may overlap buffered data. Write it first so it doesn't overwrite this call later
+  Flush();
+  if (!WriteAt(ptr, offset, size))
+  {
+    Good = false;
+  }
+}
+
+void FWriteStream::SetPosition(FILE_OFFSET pos)
+{
+  if (pos == GetPosition())
+  {
+    return;
+  }
+  Flush();
+  BufferOffset = pos;
+}
+
+void FWriteStream::Close()
+{
+  Flush();
+  if (Handle)
+  {
+    CloseHandle(Handle);
+    Handle = nullptr;
+  }
+  Good = false;
+  InlineCursor = InlineEnd = Buffer.data();
+}
+
 FStream& FStream::operator<<(FStringRef& r)
 {
   if (IsReading())
@@ -17,81 +17,81 @@ public:
 
   inline FStream& operator<<(int8& v)
   {
-    SerializeBytes(&v, 1);
+    SerializeInline(&v, 1);
     return *this;
   }
 
   inline FStream& operator<<(uint8& v)
   {
-    SerializeBytes(&v, 1);
+    SerializeInline(&v, 1);
     return *this;
   }
 
   inline FStream& operator<<(int16& v)
   {
-    SerializeBytes(&v, 2);
+    SerializeInline(&v, 2);
     return *this;
   }
 
   inline FStream& operator<<(uint16& v)
   {
-    SerializeBytes(&v, 2);
+    SerializeInline(&v, 2);
     return *this;
   }
 
   inline FStream& operator<<(int32& v)
   {
-    SerializeBytes(&v, 4);
+    SerializeInline(&v, 4);
     return *this;
   }
 
   inline FStream& operator<<(uint32& v)
   {
-    SerializeBytes(&v, 4);
+    SerializeInline(&v, 4);
     return *this;
   }
 
   inline FStream& operator<<(int64& v)
   {
-    SerializeBytes(&v, 8);
+    SerializeInline(&v, 8);
     return *this;
   }
 
   inline FStream& operator<<(uint64& v)
   {
-    SerializeBytes(&v, 8);
+    SerializeInline(&v, 8);
     return *this;
   }
 
   inline FStream& operator<<(char& v)
   {
-    SerializeBytes(&v, 1);
+    SerializeInline(&v, 1);
     return *this;
   }
 
   inline FStream& operator<<(wchar& v)
   {
-    SerializeBytes(&v, 2);
+    SerializeInline(&v, 2);
     return *this;
   }
 
   inline FStream& operator<<(bool& v)
   {
     int32 intv = v ? 1 : 0;
-    SerializeBytes(&intv, 4);
+    SerializeInline(&intv, 4);
     v = (bool)intv;
     return *this;
   }
 
   inline FStream& operator<<(float& v)
   {
-    SerializeBytes(&v, 4);
+    SerializeInline(&v, 4);
     return *this;
   }
 
   inline FStream& operator<<(double& v)
   {
-    SerializeBytes(&v, 8);
+    SerializeInline(&v, 8);
     return *this;
   }
 
@@ -179,8 +179,8 @@ public:
     return *this;
   }
 
-  template <typename Tk, typename Tv>
-  inline FStream& operator<<(std::unordered_map<Tk, Tv>& map)
+  template <typename Tk, typename Tv, typename Th, typename Te>
+  inline FStream& operator<<(std::unordered_map<Tk, Tv, Th, Te>& map)
   {
     uint32 cnt = (uint32)map.size();
     (*this) << cnt;
@@ -279,189 +279,153 @@ public:
 
   uint16 GetLV() const;
 
+  // Buffer size of new FReadStream and FWriteStream objects
+  static void SetFileBufferSize(size_t size);
+  static size_t GetFileBufferSize();
+
+protected:
+  // Small values are copied to/from the buffer of buffered streams without a virtual call
+  inline void SerializeInline(void* ptr, FILE_OFFSET size)
+  {
+    if (InlineEnd - InlineCursor >= size)
+    {
+      if (Reading)
+      {
+        memcpy(ptr, InlineCursor, size);
+      }
+      else
+      {
+        memcpy(InlineCursor, ptr, size);
+      }
+      InlineCursor += size;
+      return;
+    }
+    SerializeBytes(ptr, size);
+  }
+
 protected:
   bool Reading = false;
   FPackage* Package = nullptr;
   bool LoadSerializedObjects = true;
+  // Part of the stream buffer available for the inline path. Streams without a buffer leave them empty.
+  uint8* InlineCursor = nullptr;
+  uint8* InlineEnd = nullptr;
 };
 
+// Buffered file streams. Small reads and writes are copied to/from a user-space buffer
+// and never reach the OS. Positional calls (SerializeBytesAt) don't move the stream.
 class FReadStream : public FStream {
 public:
   FReadStream(const std::string& path)
-    : FStream()
-    , Path(path)
-    , Stream(A2W(path), std::ios::binary)
-  {
-    Reading = true;
-  }
+    : FReadStream(FString(path))
+  {}
 
   FReadStream(const std::wstring& path)
-    : FStream()
-    , Path(W2A(path))
-    , Stream(path, std::ios::binary)
-  {
-    Reading = true;
-  }
+    : FReadStream(FString(W2A(path)))
+  {}
 
-  FReadStream(const FString& path)
-    : FStream()
-    , Path(path)
-    , Stream(path.WString(), std::ios::binary)
-  {
-    Reading = true;
-  }
+  FReadStream(const FString& path);
 
   FReadStream(const FReadStream& s)
-    : FStream()
-    , Path(s.Path)
-    , Stream(s.Path.WString(), std::ios::in | std::ios::binary)
-  {
-    Reading = true;
-  }
+    : FReadStream(s.Path)
+  {}
 
-  FReadStream(FReadStream* s)
-    : FStream()
-    , Path(s->Path)
-    , Stream(A2W(s->Path), std::ios::in | std::ios::binary)
-  {
-    Reading = true;
-    Stream.seekg(s->Stream.tellg());
-  }
+  // Open the same file at the same position
+  FReadStream(FReadStream* s);
 
-  ~FReadStream()
-  {
-    Stream.close();
-  }
+  ~FReadStream();
 
-  void SerializeBytes(void* ptr, FILE_OFFSET size) override
-  {
-    if (ptr && size)
-    {
-      Stream.read((char*)ptr, size);
-    }
-  }
+  FReadStream& operator=(const FReadStream&) = delete;
 
-  void SerializeBytesAt(void* ptr, FILE_OFFSET offset, FILE_OFFSET size) override
-  {
-    auto pos = Stream.tellg();
-    Stream.seekg(offset);
-    Stream.read((char*)ptr, size);
-    Stream.seekg(pos);
-  }
+  void SerializeBytes(void* ptr, FILE_OFFSET size) override;
+
+  void SerializeBytesAt(void* ptr, FILE_OFFSET offset, FILE_OFFSET size) override;
 
   FILE_OFFSET GetPosition() override
   {
-    return (FILE_OFFSET)Stream.tellg();
+    return BufferOffset + (FILE_OFFSET)(InlineCursor - Buffer.data());
   }
 
-  void SetPosition(FILE_OFFSET pos) override
-  {
-    Stream.seekg(pos);
-  }
+  void SetPosition(FILE_OFFSET pos) override;
 
   FILE_OFFSET GetSize() override
   {
-    FILE_OFFSET size = 0;
-    if (IsGood())
-    {
-      FILE_OFFSET tmpPos = GetPosition();
-      Stream.seekg(0, std::ios::end);
-      size = GetPosition();
-      SetPosition(tmpPos);
-    }
-    return size;
+    return Good ? FileSize : 0;
   }
 
   bool IsGood() const override
   {
-    return Stream.good();
+    return Good;
   }
 
-  void Close() override
-  {
-    Stream.close();
-  }
+  void Close() override;
+
+protected:
+  // Read at most size bytes at the offset. Returns the number of bytes read
+  size_t ReadAt(void* ptr, FILE_OFFSET offset, size_t size);
 
 protected:
   FString Path;
-  std::ifstream Stream;
+  void* Handle = nullptr;
+  FILE_OFFSET FileSize = 0;
+  bool Good = false;
+  std::vector<uint8> Buffer;
+  // File offset of the first byte in the Buffer
+  FILE_OFFSET BufferOffset = 0;
 };
 
 class FWriteStream : public FStream {
 public:
-  FWriteStream(const FString& path, bool trunk = true)
-    : FStream()
-    , Path(path)
-    , Stream(path.WString(), trunk ? (std::ios::out | std::ios::trunc | std::ios::binary) : (std::ios::out | std::ios::binary))
-  {
-    Reading = false;
-  }
+  // trunk = false keeps the contents of an existing file. The file must exist.
+  FWriteStream(const FString& path, bool trunk = true);
 
   FWriteStream(const std::wstring& path, bool trunk = true)
-    : FStream()
-    , Path(W2A(path))
-    , Stream(path, trunk ? (std::ios::out | std::ios::trunc | std::ios::binary) : (std::ios::out | std::ios::binary))
-  {
-    Reading = false;
-  }
+    : FWriteStream(FString(W2A(path)), trunk)
+  {}
 
-  ~FWriteStream()
-  {
-    Stream.close();
-  }
+  FWriteStream(const FWriteStream&) = delete;
 
-  void SerializeBytes(void* ptr, FILE_OFFSET size) override
-  {
-    if (ptr && size)
-    {
-      Stream.write((const char*)ptr, size);
-    }
-  }
+  ~FWriteStream();
 
-  void SerializeBytesAt(void* ptr, FILE_OFFSET offset, FILE_OFFSET size) override
-  {
-    auto pos = Stream.tellp();
-    Stream.seekp(offset);
-    Stream.write((char*)ptr, size);
-    Stream.seekp(pos);
-  }
+  FWriteStream& operator=(const FWriteStream&) = delete;
+
+  void SerializeBytes(void* ptr, FILE_OFFSET size) override;
+
+  void SerializeBytesAt(void* ptr, FILE_OFFSET offset, FILE_OFFSET size) override;
 
   FILE_OFFSET GetPosition() override
   {
-    return (FILE_OFFSET)Stream.tellp();
+    return BufferOffset + (FILE_OFFSET)(InlineCursor - Buffer.data());
   }
 
-  void SetPosition(FILE_OFFSET pos) override
-  {
-    Stream.seekp(pos);
-  }
+  void SetPosition(FILE_OFFSET pos) override;
 
   FILE_OFFSET GetSize() override
   {
-    FILE_OFFSET size = 0;
-    if (IsGood())
-    {
-      FILE_OFFSET tmpPos = GetPosition();
-      Stream.seekp(0, std::ios::end);
-      size = GetPosition();
-      SetPosition(tmpPos);
-    }
-    return size;
+    return Good ? std::max(FileSize, GetPosition()) : 0;
   }
 
   bool IsGood() const override
   {
-    return Stream.good();
+    return Good;
   }
 
-  void Close() override
-  {
-    Stream.close();
-  }
+  void Close() override;
+
+  // Write buffered data to the file
+  void Flush();
+
+protected:
+  bool WriteAt(const void* ptr, FILE_OFFSET offset, size_t size);
 
 protected:
   FString Path;
-  std::ofstream Stream;
+  void* Handle = nullptr;
+  FILE_OFFSET FileSize = 0;
+  bool Good = false;
+  std::vector<uint8> Buffer;
+  // File offset of the first byte in the Buffer. Data before the InlineCursor is not written yet
+  FILE_OFFSET BufferOffset = 0;
 };
 
 // Stream to read from memory. fakeOffset emulates position in file for Get/SetPosition
@@ -555,6 +519,78 @@ protected:
   size_t Size = 0;
 };
 
+// Reads a range of the source stream from memory. Positions are offsets in the source.
+// Reads outside of the range are passed to the source stream.
+class MSliceReadStream : public FStream {
+public:
+  MSliceReadStream(FStream* source, const uint8* data, FILE_OFFSET offset, FILE_OFFSET size)
+    : Source(source)
+    , Data(data)
+    , Offset(offset)
+    , Size(size)
+  {
+    Reading = true;
+    Good = Source && Source->IsGood();
+    Package = Source ? Source->GetPackage() : nullptr;
+    LoadSerializedObjects = Source ? Source->GetLoadSerializedObjects() : true;
+    Position = Offset;
+  }
+
+  void SerializeBytes(void* ptr, FILE_OFFSET size) override
+  {
+    SerializeBytesAt(ptr, Position, size);
+    Position += size;
+  }
+
+  void SerializeBytesAt(void* ptr, FILE_OFFSET offset, FILE_OFFSET size) override
+  {
+    if (!ptr || !size || !Good)
+    {
+      return;
+    }
+    if (offset >= Offset && offset + size <= Offset + Size)
+    {
+      memcpy(ptr, Data + (offset - Offset), size);
+      return;
+    }
+    Source->SerializeBytesAt(ptr, offset, size);
+    Good = Source->IsGood();
+  }
+
+  void SetPosition(FILE_OFFSET offset) override
+  {
+    Position = offset;
+  }
+
+  FILE_OFFSET GetPosition() override
+  {
+    return Position;
+  }
+
+  FILE_OFFSET GetSize() override
+  {
+    return Source->GetSize();
+  }
+
+  bool IsGood() const override
+  {
+    return Good;
+  }
+
+  void Close() override
+  {
+    Good = false;
+  }
+
+protected:
+  FStream* Source = nullptr;
+  const uint8* Data = nullptr;
+  FILE_OFFSET Offset = 0;
+  FILE_OFFSET Size = 0;
+  FILE_OFFSET Position = 0;
+  bool Good = false;
+};
+
 class MWrightStream : public FStream {
 public:
   MWrightStream(void* data, size_t size, size_t fakeOffset = 0)
@@ -4,9 +4,8 @@
 
 FString FStringRef::GetString()
 {
-  FReadStream s(Package->GetDataPath());
-  s.SetPackage(Package);
-  return GetString(s);
+  std::unique_ptr<FStream> s = Package->CreateDataStream();
+  return GetString(*s);
 }
 
 FString FStringRef::GetString(FStream& s)
@@ -3,6 +3,106 @@
 #include "Core.h"
 
 #include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+// Non-owning view of a string. Ignores the trailing '\0' the same way FString comparison does
+class FStringView {
+public:
+  FStringView()
+  {}
+
+  FStringView(const char* str)
+    : Data(str ? str : "")
+  {}
+
+  FStringView(const char* str, size_t len)
+    : Data(str, len)
+  {
+    Trim();
+  }
+
+  FStringView(const std::string& str)
+    : Data(str)
+  {
+    Trim();
+  }
+
+  FStringView(std::string_view str)
+    : Data(str)
+  {
+    Trim();
+  }
+
+  inline size_t Size() const
+  {
+    return Data.size();
+  }
+
+  inline bool Empty() const
+  {
+    return Data.empty();
+  }
+
+  inline const char* Ptr() const
+  {
+    return Data.data();
+  }
+
+  inline std::string_view View() const
+  {
+    return Data;
+  }
+
+  inline bool operator==(FStringView a) const
+  {
+    return Data == a.Data;
+  }
+
+  inline bool operator!=(FStringView a) const
+  {
+    return Data != a.Data;
+  }
+
+  inline bool EqualsIgnoreCase(FStringView a) const
+  {
+    if (Data.size() != a.Data.size())
+    {
+      return false;
+    }
+    for (size_t idx = 0; idx < Data.size(); ++idx)
+    {
+      if (::toupper((unsigned char)Data[idx]) != ::toupper((unsigned char)a.Data[idx]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // FNV-1a of the upper-case string
+  inline size_t HashIgnoreCase() const
+  {
+    uint64 hash = 14695981039346656037ULL;
+    for (const char ch : Data)
+    {
+      hash ^= (uint64)::toupper((unsigned char)ch);
+      hash *= 1099511628211ULL;
+    }
+    return (size_t)hash;
+  }
+
+private:
+  inline void Trim()
+  {
+    if (Data.size() && Data.back() == 0)
+    {
+      Data.remove_suffix(1);
+    }
+  }
+
+  std::string_view Data;
+};
 
 // Wrapper to keep track of '\0'
 class FString {
@@ -23,25 +123,31 @@ public:
   {}
 
   FString(const wchar* str)
-    : Data(W2A(str))
-  {}
+  {
+    if (str)
+    {
+      UTF16ToUTF8(str, wcslen(str), Data);
+    }
+  }
 
   FString(const std::string& str)
     : Data(str)
   {}
 
   FString(const std::wstring& str)
-    : Data(W2A(str))
-  {}
+  {
+    UTF16ToUTF8(str.c_str(), str.size(), Data);
+  }
 
   inline size_t Size() const
   {
     return Data.size();
   }
 
+  // Number of characters without the trailing '\0'. Size() is the serialized size.
   inline size_t Length() const
   {
-    return Data.size();
+    return View().Size();
   }
 
   inline bool Empty() const
@@ -106,11 +212,7 @@ public:
 
   inline bool operator==(const char* a) const
   {
-    if (!a && Data.empty())
-    {
-      return true;
-    }
-    return *this == std::string(a);
+    return View() == FStringView(a);
   }
 
   inline std::wstring FStringByAppendingPath(const FString& path)
@@ -199,51 +301,17 @@ public:
 
   inline bool operator==(const FString& a) const
   {
-    if (Data.empty())
-    {
-      return a.Data.empty() ? true : a.Data.size() == 1 && a.Data.front() == 0;
-    }
-    else if (a.Data.empty())
-    {
-      return Data.empty() ? true : Data.size() == 1 && Data.front() == 0;
-    }
-
-    if (Data.back() == 0 && a.Data.back() != 0)
-    {
-      return Data.substr(0, Data.size() - 1) == a.Data;
-    }
-    else if (a.Data.back() == 0 && Data.back() != 0)
-    {
-      return a.Data.substr(0, a.Data.size() - 1) == Data;
-    }
-    return Data == a.Data;
+    return View() == a.View();
   }
 
   inline bool operator==(const std::string& a) const
   {
-    if (Data.empty())
-    {
-      return a.empty() ? true : a.size() == 1 && a.front() == 0;
-    }
-    else if (a.empty())
-    {
-      return Data.empty() ? true : Data.size() == 1 && Data.front() == 0;
-    }
-    
-    if (Data.back() == 0 && a.back() != 0)
-    {
-      return Data.substr(0, Data.size() - 1) == a;
-    }
-    else if (a.back() == 0 && Data.back() != 0)
-    {
-      return a.substr(0, a.size() - 1) == Data;
-    }
-    return Data == a;
+    return View() == FStringView(a);
   }
 
   inline bool operator!=(const char* a) const
   {
-    return (*this) != std::string(a);
+    return !(*this == a);
   }
 
   inline bool operator!=(const FString& a) const
@@ -256,6 +324,17 @@ public:
     return !(*this == a);
   }
 
+  // View without the trailing '\0'
+  inline FStringView View() const
+  {
+    return FStringView(Data);
+  }
+
+  inline operator FStringView() const
+  {
+    return View();
+  }
+
   inline operator std::string() const
   {
     return Data;
@@ -272,7 +351,7 @@ public:
     bool appnedNull = false;
     if (s.Size() && s.Back() == 0)
     {
-      s.Data = s.Data.substr(0, s.Data.size() - 1);
+      s.Data.pop_back();
       appnedNull = str.empty() || str.back() != 0;
     }
     s.Data += str;
@@ -288,7 +367,7 @@ public:
     bool appnedNull = false;
     if (Data.size() && Data.back() == 0)
     {
-      Data = Data.substr(0, Data.size() - 1);
+      Data.pop_back();
       appnedNull = str.empty() || str.back() != 0;
     }
     Data += str;
@@ -305,7 +384,7 @@ public:
     bool appnedNull = false;
     if (s.Size() && s.Back() == 0)
     {
-      s.Data = s.Data.substr(0, s.Data.size() - 1);
+      s.Data.pop_back();
       appnedNull = str.Data.empty() || str.Data.back() != 0;
     }
     s.Data += str.Data;
@@ -321,7 +400,7 @@ public:
     bool appnedNull = false;
     if (Data.size() && Data.back() == 0)
     {
-      Data = Data.substr(0, Data.size() - 1);
+      Data.pop_back();
       appnedNull = str.Data.empty() || str.Data.back() != 0;
     }
     Data += str.Data;
@@ -397,6 +476,13 @@ public:
     Data.reserve(size);
   }
 
+  // Replace the content with UTF16 characters
+  inline void AssignUTF16(const wchar* str, size_t len)
+  {
+    Data.clear();
+    UTF16ToUTF8(str, len, Data);
+  }
+
   void Terminate()
   {
     if (Data.size() && Data.back())
@@ -419,18 +505,9 @@ public:
 
   inline bool StartWith(const FString& s) const
   {
-    if (Data.size() && s.Size())
-    {
-      if (Data.back() && !s.Back())
-      {
-        return Data._Starts_with(s.Data.substr(0, s.Data.size() - 1));
-      }
-      else if (!Data.back() && s.Back())
-      {
-        return Data.substr(0, Data.size() - 1)._Starts_with(s.Data);
-      }
-    }
-    return Data._Starts_with(s.Data);
+    std::string_view str = View().View();
+    std::string_view prefix = s.View().View();
+    return str.size() >= prefix.size() && !str.compare(0, prefix.size(), prefix);
   }
 
   int Compare(size_t off, size_t count, const char* str) const
@@ -560,11 +637,43 @@ namespace std
   {
     std::size_t operator()(const FString& a) const
     {
-      return std::hash<std::string>()(a.StringForHash());
+      return std::hash<std::string_view>()(a.View().View());
+    }
+  };
+
+  template <>
+  struct hash<FStringView>
+  {
+    std::size_t operator()(const FStringView& a) const
+    {
+      return std::hash<std::string_view>()(a.View());
     }
   };
 }
 
+// Case-insensitive hasher and comparator for FString keys. Both accept views and never allocate.
+struct FStringHashIgnoreCase {
+  using is_transparent = void;
+
+  std::size_t operator()(FStringView a) const
+  {
+    return a.HashIgnoreCase();
+  }
+};
+
+struct FStringEqualIgnoreCase {
+  using is_transparent = void;
+
+  bool operator()(FStringView a, FStringView b) const
+  {
+    return a.EqualsIgnoreCase(b);
+  }
+};
+
+// Hash map with case-insensitive FString keys. Keys don't need to be converted with ToUpper().
+template <typename TValue>
+using FStringMap = std::unordered_map<FString, TValue, FStringHashIgnoreCase, FStringEqualIgnoreCase>;
+
 class FStringRef {
 public:
   FStringRef()
@@ -1,6 +1,7 @@
 #include "FStructs.h"
 #include "FStream.h"
 #include "UObject.h"
+#include "FPackage.h"
 
 const FMatrix FMatrix::Identity(FPlane(1, 0, 0, 0), FPlane(0, 1, 0, 0), FPlane(0, 0, 1, 0), FPlane(0, 0, 0, 1));
 
@@ -414,6 +415,15 @@ void FUntypedBulkData::Serialize(FStream& s, UObject* owner, int32 idx)
     }
     else
     {
+      if (!IsMaterialized())
+      {
+        Materialize();
+      }
+      if (!BulkData && GetBulkDataSize() > 0)
+      {
+        // Writing the header without the payload would corrupt the package
+        UThrow("Failed to read bulk data of %s!", owner ? owner->GetFullObjectName().C_str() : "an object");
+      }
       SavedBulkDataFlags = BulkDataFlags;
       SavedElementCount = ElementCount;
       int32 SavedBulkDataSizeOnDiskPos = INDEX_NONE;
@@ -445,6 +455,64 @@ void FUntypedBulkData::Serialize(FStream& s, UObject* owner, int32 idx)
   }
 }
 
+void FUntypedBulkData::SetSharedData(const std::shared_ptr<void>& data, int32 elementCount)
+{
+  if (OwnsMemory)
+  {
+    free(BulkData);
+  }
+  OwnsMemory = false;
+  SharedData = data;
+  BulkData = data.get();
+  ElementCount = elementCount;
+  LazyPayloadOffset = INDEX_NONE;
+}
+
+void FUntypedBulkData::SerializeLazy(FStream& s, UObject* owner, int32 idx)
+{
+  if (!s.IsReading() || !s.GetPackage())
+  {
+    Serialize(s, owner, idx);
+    return;
+  }
+  s << BulkDataFlags;
+  s << ElementCount;
+  s << BulkDataSizeOnDisk;
+  s << BulkDataOffsetInFile;
+  if ((BulkDataFlags & BULKDATA_StoreInSeparateFile) || (BulkDataFlags & BULKDATA_Unused))
+  {
+    return;
+  }
+  Package = s.GetPackage();
+  LazyPayloadOffset = s.GetPosition();
+  const FILE_OFFSET sizeOnDisk = (BulkDataFlags & BULKDATA_SerializeCompressed) ? BulkDataSizeOnDisk : GetBulkDataSize();
+  s.SetPosition(LazyPayloadOffset + sizeOnDisk);
+}
+
+bool FUntypedBulkData::Materialize()
+{
+  if (IsMaterialized())
+  {
+    return BulkData;
+  }
+  if (!Package || GetBulkDataSize() <= 0)
+  {
+    LazyPayloadOffset = INDEX_NONE;
+    return false;
+  }
+
+  void* data = malloc(GetBulkDataSize());
+  if (!Package->ReadDeferredData(LazyPayloadOffset, [&](FStream& s) { SerializeBulkData(s, data); }))
+  {
+    LogE("Failed to read bulk data!");
+    free(data);
+    return false;
+  }
+  OwnsMemory = true;
+  BulkData = data;
+  return true;
+}
+
 void FUntypedBulkData::SerializeSeparate(FStream& s, UObject* owner, int32 idx)
 {
   bool hasFlag = BulkDataFlags & BULKDATA_StoreInSeparateFile;
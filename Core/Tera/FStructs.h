@@ -3,6 +3,8 @@
 #include "FString.h"
 #include "FName.h"
 
+#include <memory>
+
 struct FGuid
 {
 public:
@@ -449,8 +451,13 @@ struct FUntypedBulkData
 		OwnsMemory = true;
 		BulkData = malloc(elementCount * GetElementSize());
 		ElementCount = elementCount;
+		LazyPayloadOffset = INDEX_NONE;
+		SharedData.reset();
 	}
 
+	// Use a buffer shared with other bulk data objects. The buffer must not be modified
+	void SetSharedData(const std::shared_ptr<void>& data, int32 elementCount);
+
 	int32 GetElementCount() const;
 
 	int32 GetBulkDataSize() const;
@@ -469,6 +476,19 @@ struct FUntypedBulkData
 
 	void SerializeSeparate(FStream& s, UObject* owner, int32 idx = INDEX_NONE);
 
+	// Same as Serialize, but a reading stream only records where the payload is and skips it.
+	// The payload is read from the package on the first Materialize call.
+	void SerializeLazy(FStream& s, UObject* owner, int32 idx = INDEX_NONE);
+
+	// Read the deferred payload. Not thread-safe: the owner must synchronize access.
+	// Returns false if there is no data or the read failed.
+	bool Materialize();
+
+	bool IsMaterialized() const
+	{
+		return BulkData || LazyPayloadOffset == INDEX_NONE;
+	}
+
 	void SerializeBulkData(FStream& s, void* data);
 
 	virtual bool RequiresSingleElementSerialization(FStream& s);
@@ -493,6 +513,9 @@ protected:
 	bool OwnsMemory = false;
 	void* BulkData = nullptr;
 	FPackage* Package = nullptr;
+	// Position of a payload that was skipped by SerializeLazy
+	FILE_OFFSET LazyPayloadOffset = INDEX_NONE;
+	std::shared_ptr<void> SharedData;
 };
 
 struct FByteBulkData : public FUntypedBulkData
@@ -69,14 +69,8 @@ bool UStaticMeshActor::RegisterProperty(FPropertyTag* property)
   if (PROP_IS(property, StaticMeshComponent))
   {
     StaticMeshComponentProperty = property;
-    StaticMeshComponent = Cast<UStaticMeshComponent>(GetPackage()->GetObject(property->Value->GetObjectIndex(), false));
+    StaticMeshComponent = TObjectRef<UStaticMeshComponent>(GetPackage(), property->Value->GetObjectIndex());
     return true;
   }
   return false;
 }
-
-void UStaticMeshActor::PostLoad()
-{
-  Super::PostLoad();
-  LoadObject(StaticMeshComponent);
-}
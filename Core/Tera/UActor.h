@@ -24,7 +24,5 @@ public:
 
   bool RegisterProperty(FPropertyTag* property) override;
 
-  UPROP(UStaticMeshComponent*, StaticMeshComponent, nullptr);
-
-  void PostLoad() override;
+  UPROP(TObjectRef<UStaticMeshComponent>, StaticMeshComponent, nullptr);
 };
\ No newline at end of file
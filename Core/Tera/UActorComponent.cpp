@@ -45,7 +45,7 @@ bool UPrimitiveComponent::RegisterProperty(FPropertyTag* property)
   if (PROP_IS(property, ReplacementPrimitive))
   {
     ReplacementPrimitiveProperty = property;
-    ReplacementPrimitive = Cast<UPrimitiveComponent>(GetPackage()->GetObject(property->Value->GetObjectIndex(), false));
+    ReplacementPrimitive = TObjectRef<UPrimitiveComponent>(GetPackage(), property->Value->GetObjectIndex());
     return true;
   }
   if (PROP_IS(property, CastShadow))
@@ -56,9 +56,3 @@ bool UPrimitiveComponent::RegisterProperty(FPropertyTag* property)
   }
   return false;
 }
-
-void UPrimitiveComponent::PostLoad()
-{
-  Super::PostLoad();
-  LoadObject(ReplacementPrimitive);
-}
\ No newline at end of file
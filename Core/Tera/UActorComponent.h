@@ -19,10 +19,8 @@ public:
 
   bool RegisterProperty(FPropertyTag* property) override;
 
-  UPROP(UPrimitiveComponent*, ReplacementPrimitive, nullptr);
+  UPROP(TObjectRef<UPrimitiveComponent>, ReplacementPrimitive, nullptr);
   UPROP(bool, CastShadow, true);
-
-  void PostLoad() override;
 };
 
 class UMeshComponent : public UPrimitiveComponent {
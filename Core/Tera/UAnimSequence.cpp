@@ -1,4 +1,512 @@
 #include "UAnimSequence.h"
+#include "FPackage.h"
+
+#include <cmath>
+#include <emmintrin.h>
+
+namespace
+{
+  inline uint32 Align4(uint32 value)
+  {
+    return (value + 3) & ~3u;
+  }
+
+  inline float ComputeW(float x, float y, float z)
+  {
+    const float ww = 1.f - x * x - y * y - z * z;
+    return ww > 0.f ? sqrtf(ww) : 0.f;
+  }
+
+  inline uint32 ReadPacked(const uint8* data)
+  {
+    uint32 packed = 0;
+    memcpy(&packed, data, sizeof(packed));
+    return packed;
+  }
+
+  // Key decoders. mins and ranges are set for interval formats only
+  void DecodeRotationNone(const uint8* data, const float* mins, const float* ranges, FQuat& out)
+  {
+    memcpy(&out.X, data, sizeof(float) * 4);
+  }
+
+  void DecodeRotationFloat96(const uint8* data, const float* mins, const float* ranges, FQuat& out)
+  {
+    memcpy(&out.X, data, sizeof(float) * 3);
+    out.W = ComputeW(out.X, out.Y, out.Z);
+  }
+
+  void DecodeRotationFixed48(const uint8* data, const float* mins, const float* ranges, FQuat& out)
+  {
+    uint16 v[3];
+    memcpy(v, data, sizeof(v));
+    out.X = ((int32)v[0] - 32767) / 32767.f;
+    out.Y = ((int32)v[1] - 32767) / 32767.f;
+    out.Z = ((int32)v[2] - 32767) / 32767.f;
+    out.W = ComputeW(out.X, out.Y, out.Z);
+  }
+
+  void DecodeRotationFixed32(const uint8* data, const float* mins, const float* ranges, FQuat& out)
+  {
+    const uint32 packed = ReadPacked(data);
+    out.X = ((int32)(packed >> 21) - 1023) / 1023.f;
+    out.Y = ((int32)((packed >> 10) & 0x7FF) - 1023) / 1023.f;
+    out.Z = ((int32)(packed & 0x3FF) - 511) / 511.f;
+    out.W = ComputeW(out.X, out.Y, out.Z);
+  }
+
+  void DecodeRotationIntervalFixed32(const uint8* data, const float* mins, const float* ranges, FQuat& out)
+  {
+    const uint32 packed = ReadPacked(data);
+    out.X = ((int32)(packed >> 21) - 1023) / 1023.f * ranges[0] + mins[0];
+    out.Y = ((int32)((packed >> 10) & 0x7FF) - 1023) / 1023.f * ranges[1] + mins[1];
+    out.Z = ((int32)(packed & 0x3FF) - 511) / 511.f * ranges[2] + mins[2];
+    out.W = ComputeW(out.X, out.Y, out.Z);
+  }
+
+  // 11-11-10 bit floats: 3 bit exponent, 7 (6 for Z) bit mantissa, sign
+  void DecodeRotationFloat32(const uint8* data, const float* mins, const float* ranges, FQuat& out)
+  {
+    const uint32 packed = ReadPacked(data);
+    const uint32 x = packed >> 21;
+    const uint32 y = (packed >> 10) & 0x7FF;
+    const uint32 z = packed & 0x3FF;
+    const uint32 fx = ((((x >> 7) & 7) + 123) << 23) | (((x & 0x7F) | ((x & 0x400) << 5)) << 16);
+    const uint32 fy = ((((y >> 7) & 7) + 123) << 23) | (((y & 0x7F) | ((y & 0x400) << 5)) << 16);
+    const uint32 fz = ((((z >> 6) & 7) + 123) << 23) | (((z & 0x3F) | ((z & 0x200) << 5)) << 17);
+    memcpy(&out.X, &fx, sizeof(float));
+    memcpy(&out.Y, &fy, sizeof(float));
+    memcpy(&out.Z, &fz, sizeof(float));
+    out.W = ComputeW(out.X, out.Y, out.Z);
+  }
+
+  void DecodeRotationIdentity(const uint8* data, const float* mins, const float* ranges, FQuat& out)
+  {
+    out.X = out.Y = out.Z = 0.f;
+    out.W = 1.f;
+  }
+
+  void DecodeTranslationFloat96(const uint8* data, const float* mins, const float* ranges, FVector& out)
+  {
+    memcpy(&out.X, data, sizeof(float) * 3);
+  }
+
+  void DecodeTranslationFixed48(const uint8* data, const float* mins, const float* ranges, FVector& out)
+  {
+    uint16 v[3];
+    memcpy(v, data, sizeof(v));
+    out.X = ((int32)v[0] - 32767) * (128.f / 32767.f);
+    out.Y = ((int32)v[1] - 32767) * (128.f / 32767.f);
+    out.Z = ((int32)v[2] - 32767) * (128.f / 32767.f);
+  }
+
+  void DecodeTranslationIntervalFixed32(const uint8* data, const float* mins, const float* ranges, FVector& out)
+  {
+    const uint32 packed = ReadPacked(data);
+    out.X = ((int32)(packed & 0x3FF) - 511) / 511.f * ranges[0] + mins[0];
+    out.Y = ((int32)((packed >> 10) & 0x7FF) - 1023) / 1023.f * ranges[1] + mins[1];
+    out.Z = ((int32)(packed >> 21) - 1023) / 1023.f * ranges[2] + mins[2];
+  }
+
+  void DecodeTranslationIdentity(const uint8* data, const float* mins, const float* ranges, FVector& out)
+  {
+    out.X = out.Y = out.Z = 0.f;
+  }
+
+  template <typename T>
+  struct FKeyCodec {
+    void(*Decode)(const uint8* data, const float* mins, const float* ranges, T& out) = nullptr;
+    uint32 KeySize = 0;
+    bool HasRange = false;
+  };
+
+  FKeyCodec<FQuat> GetRotationCodec(AnimationCompressionFormat format)
+  {
+    switch (format)
+    {
+    case ACF_None:
+      return { DecodeRotationNone, 16, false };
+    case ACF_Float96NoW:
+      return { DecodeRotationFloat96, 12, false };
+    case ACF_Fixed48NoW:
+      return { DecodeRotationFixed48, 6, false };
+    case ACF_IntervalFixed32NoW:
+      return { DecodeRotationIntervalFixed32, 4, true };
+    case ACF_Fixed32NoW:
+      return { DecodeRotationFixed32, 4, false };
+    case ACF_Float32NoW:
+      return { DecodeRotationFloat32, 4, false };
+    case ACF_Identity:
+      return { DecodeRotationIdentity, 0, false };
+    default:
+      return {};
+    }
+  }
+
+  FKeyCodec<FVector> GetTranslationCodec(AnimationCompressionFormat format)
+  {
+    switch (format)
+    {
+    case ACF_None:
+    case ACF_Float96NoW:
+      return { DecodeTranslationFloat96, 12, false };
+    case ACF_Fixed48NoW:
+      return { DecodeTranslationFixed48, 6, false };
+    case ACF_IntervalFixed32NoW:
+      return { DecodeTranslationIntervalFixed32, 4, true };
+    case ACF_Identity:
+      return { DecodeTranslationIdentity, 0, false };
+    default:
+      return {};
+    }
+  }
+
+  // Find two keys around the relative position. frameTable is null for evenly spaced keys
+  void FindKeys(float relativePos, int32 numKeys, int32 numFrames, const uint8* frameTable, int32& key0, int32& key1, float& alpha)
+  {
+    key0 = key1 = 0;
+    alpha = 0.f;
+    if (numKeys < 2)
+    {
+      return;
+    }
+    if (!frameTable)
+    {
+      const float keyPos = relativePos * (numKeys - 1);
+      key0 = std::clamp((int32)keyPos, 0, numKeys - 1);
+      key1 = std::min(key0 + 1, numKeys - 1);
+      alpha = std::clamp(keyPos - key0, 0.f, 1.f);
+      return;
+    }
+    auto frameAt = [&](int32 key) -> int32 {
+      if (numFrames < 256)
+      {
+        return frameTable[key];
+      }
+      uint16 frame = 0;
+      memcpy(&frame, frameTable + key * 2, sizeof(frame));
+      return frame;
+    };
+    const float framePos = relativePos * std::max(numFrames - 1, 0);
+    int32 lo = 0;
+    int32 hi = numKeys - 1;
+    while (lo < hi)
+    {
+      const int32 mid = (lo + hi + 1) / 2;
+      if (frameAt(mid) <= framePos)
+      {
+        lo = mid;
+      }
+      else
+      {
+        hi = mid - 1;
+      }
+    }
+    key0 = lo;
+    key1 = std::min(lo + 1, numKeys - 1);
+    const int32 frame0 = frameAt(key0);
+    const int32 frame1 = frameAt(key1);
+    alpha = frame1 > frame0 ? std::clamp((framePos - frame0) / (frame1 - frame0), 0.f, 1.f) : 0.f;
+  }
+
+  // Two keys of a track component around the sampled position
+  struct FKeyPair {
+    const uint8* Key0 = nullptr;
+    const uint8* Key1 = nullptr;
+    const float* Mins = nullptr;
+    const float* Ranges = nullptr;
+    float Alpha = 0.f;
+  };
+
+  // Find two keys of a track component around the relative position. Keys are decoded later in batches
+  template <typename T>
+  bool LocateKeys(const uint8* data, int32 dataSize, int32 offset, int32 numKeys, const FKeyCodec<T>& codec, bool variableKeys, int32 numFrames, float relativePos, FKeyPair& out)
+  {
+    const int64 keysEnd = (int64)offset + (codec.HasRange ? 24 : 0) + (int64)numKeys * codec.KeySize;
+    if (offset < 0 || numKeys <= 0 || keysEnd > dataSize)
+    {
+      return false;
+    }
+    const uint8* ptr = data + offset;
+    out.Mins = nullptr;
+    out.Ranges = nullptr;
+    if (codec.HasRange)
+    {
+      out.Mins = (const float*)ptr;
+      out.Ranges = out.Mins + 3;
+      ptr += 24;
+    }
+    const uint8* frameTable = nullptr;
+    if (variableKeys && numKeys > 1)
+    {
+      const int64 tableOffset = Align4((uint32)keysEnd);
+      if (tableOffset + (int64)numKeys * (numFrames < 256 ? 1 : 2) > dataSize)
+      {
+        return false;
+      }
+      frameTable = data + tableOffset;
+    }
+    int32 key0 = 0;
+    int32 key1 = 0;
+    FindKeys(relativePos, numKeys, numFrames, frameTable, key0, key1, out.Alpha);
+    out.Key0 = ptr + key0 * codec.KeySize;
+    out.Key1 = ptr + key1 * codec.KeySize;
+    return true;
+  }
+
+  // SSE2 decoders. A call decodes one key of four tracks, lane N holds track N.
+  // The math follows the scalar decoders above, so single keys and batches give the same values.
+  struct FLanes {
+    __m128 X;
+    __m128 Y;
+    __m128 Z;
+    __m128 W;
+  };
+
+  inline __m128i GatherPacked(const uint8* const* keys)
+  {
+    return _mm_setr_epi32((int32)ReadPacked(keys[0]), (int32)ReadPacked(keys[1]), (int32)ReadPacked(keys[2]), (int32)ReadPacked(keys[3]));
+  }
+
+  inline __m128 GatherFloat(const uint8* const* keys, int32 component)
+  {
+    float v[4];
+    for (int32 lane = 0; lane < 4; ++lane)
+    {
+      memcpy(&v[lane], keys[lane] + component * sizeof(float), sizeof(float));
+    }
+    return _mm_loadu_ps(v);
+  }
+
+  inline __m128i GatherUInt16(const uint8* const* keys, int32 component)
+  {
+    uint16 v[4];
+    for (int32 lane = 0; lane < 4; ++lane)
+    {
+      memcpy(&v[lane], keys[lane] + component * sizeof(uint16), sizeof(uint16));
+    }
+    return _mm_setr_epi32(v[0], v[1], v[2], v[3]);
+  }
+
+  inline __m128 GatherInterval(const float* const* values, int32 component)
+  {
+    return _mm_setr_ps(values[0][component], values[1][component], values[2][component], values[3][component]);
+  }
+
+  // (value - bias) / bias
+  inline __m128 Dequantize(__m128i value, int32 bias)
+  {
+    return _mm_div_ps(_mm_cvtepi32_ps(_mm_sub_epi32(value, _mm_set1_epi32(bias))), _mm_set1_ps((float)bias));
+  }
+
+  inline __m128 ComputeW(__m128 x, __m128 y, __m128 z)
+  {
+    __m128 ww = _mm_sub_ps(_mm_set1_ps(1.f), _mm_mul_ps(x, x));
+    ww = _mm_sub_ps(ww, _mm_mul_ps(y, y));
+    ww = _mm_sub_ps(ww, _mm_mul_ps(z, z));
+    return _mm_sqrt_ps(_mm_max_ps(ww, _mm_setzero_ps()));
+  }
+
+  // Component of an 11-11-10 bit float key. MantissaBits is 7 for X and Y and 6 for Z
+  template <int MantissaBits>
+  inline __m128 UnpackFloat32(__m128i v)
+  {
+    const __m128i exponent = _mm_slli_epi32(_mm_add_epi32(_mm_and_si128(_mm_srli_epi32(v, MantissaBits), _mm_set1_epi32(7)), _mm_set1_epi32(123)), 23);
+    const __m128i sign = _mm_slli_epi32(_mm_and_si128(v, _mm_set1_epi32(1 << (MantissaBits + 3))), 5);
+    const __m128i mantissa = _mm_slli_epi32(_mm_or_si128(_mm_and_si128(v, _mm_set1_epi32((1 << MantissaBits) - 1)), sign), 23 - MantissaBits);
+    return _mm_castsi128_ps(_mm_or_si128(exponent, mantissa));
+  }
+
+  FLanes DecodeRotationLanes(AnimationCompressionFormat format, const uint8* const* keys, const float* const* mins, const float* const* ranges)
+  {
+    FLanes q;
+    switch (format)
+    {
+    case ACF_None:
+      q.X = GatherFloat(keys, 0);
+      q.Y = GatherFloat(keys, 1);
+      q.Z = GatherFloat(keys, 2);
+      q.W = GatherFloat(keys, 3);
+      return q;
+    case ACF_Float96NoW:
+      q.X = GatherFloat(keys, 0);
+      q.Y = GatherFloat(keys, 1);
+      q.Z = GatherFloat(keys, 2);
+      break;
+    case ACF_Fixed48NoW:
+      q.X = Dequantize(GatherUInt16(keys, 0), 32767);
+      q.Y = Dequantize(GatherUInt16(keys, 1), 32767);
+      q.Z = Dequantize(GatherUInt16(keys, 2), 32767);
+      break;
+    case ACF_Fixed32NoW:
+    case ACF_IntervalFixed32NoW:
+    {
+      const __m128i packed = GatherPacked(keys);
+      q.X = Dequantize(_mm_srli_epi32(packed, 21), 1023);
+      q.Y = Dequantize(_mm_and_si128(_mm_srli_epi32(packed, 10), _mm_set1_epi32(0x7FF)), 1023);
+      q.Z = Dequantize(_mm_and_si128(packed, _mm_set1_epi32(0x3FF)), 511);
+      if (format == ACF_IntervalFixed32NoW)
+      {
+        q.X = _mm_add_ps(_mm_mul_ps(q.X, GatherInterval(ranges, 0)), GatherInterval(mins, 0));
+        q.Y = _mm_add_ps(_mm_mul_ps(q.Y, GatherInterval(ranges, 1)), GatherInterval(mins, 1));
+        q.Z = _mm_add_ps(_mm_mul_ps(q.Z, GatherInterval(ranges, 2)), GatherInterval(mins, 2));
+      }
+      break;
+    }
+    case ACF_Float32NoW:
+    {
+      const __m128i packed = GatherPacked(keys);
+      q.X = UnpackFloat32<7>(_mm_srli_epi32(packed, 21));
+      q.Y = UnpackFloat32<7>(_mm_and_si128(_mm_srli_epi32(packed, 10), _mm_set1_epi32(0x7FF)));
+      q.Z = UnpackFloat32<6>(_mm_and_si128(packed, _mm_set1_epi32(0x3FF)));
+      break;
+    }
+    default:
+      q.X = q.Y = q.Z = _mm_setzero_ps();
+      q.W = _mm_set1_ps(1.f);
+      return q;
+    }
+    q.W = ComputeW(q.X, q.Y, q.Z);
+    return q;
+  }
+
+  FLanes DecodeTranslationLanes(AnimationCompressionFormat format, const uint8* const* keys, const float* const* mins, const float* const* ranges)
+  {
+    FLanes t;
+    t.W = _mm_setzero_ps();
+    switch (format)
+    {
+    case ACF_None:
+    case ACF_Float96NoW:
+      t.X = GatherFloat(keys, 0);
+      t.Y = GatherFloat(keys, 1);
+      t.Z = GatherFloat(keys, 2);
+      break;
+    case ACF_Fixed48NoW:
+    {
+      const __m128i bias = _mm_set1_epi32(32767);
+      const __m128 scale = _mm_set1_ps(128.f / 32767.f);
+      t.X = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(GatherUInt16(keys, 0), bias)), scale);
+      t.Y = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(GatherUInt16(keys, 1), bias)), scale);
+      t.Z = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(GatherUInt16(keys, 2), bias)), scale);
+      break;
+    }
+    case ACF_IntervalFixed32NoW:
+    {
+      // Unlike rotations X takes the low bits
+      const __m128i packed = GatherPacked(keys);
+      t.X = _mm_add_ps(_mm_mul_ps(Dequantize(_mm_and_si128(packed, _mm_set1_epi32(0x3FF)), 511), GatherInterval(ranges, 0)), GatherInterval(mins, 0));
+      t.Y = _mm_add_ps(_mm_mul_ps(Dequantize(_mm_and_si128(_mm_srli_epi32(packed, 10), _mm_set1_epi32(0x7FF)), 1023), GatherInterval(ranges, 1)), GatherInterval(mins, 1));
+      t.Z = _mm_add_ps(_mm_mul_ps(Dequantize(_mm_srli_epi32(packed, 21), 1023), GatherInterval(ranges, 2)), GatherInterval(mins, 2));
+      break;
+    }
+    default:
+      t.X = t.Y = t.Z = _mm_setzero_ps();
+      break;
+    }
+    return t;
+  }
+
+  // Lanes of a batch. Short batches repeat the last pair, so every lane reads valid memory
+  struct FBatchLanes {
+    const uint8* Keys0[4];
+    const uint8* Keys1[4];
+    const float* Mins[4];
+    const float* Ranges[4];
+    __m128 Alpha;
+  };
+
+  int32 FillLanes(const FKeyPair* pairs, int32 count, FBatchLanes& lanes)
+  {
+    const int32 used = std::min(count, 4);
+    float alpha[4];
+    for (int32 lane = 0; lane < 4; ++lane)
+    {
+      const FKeyPair& pair = pairs[std::min(lane, used - 1)];
+      lanes.Keys0[lane] = pair.Key0;
+      lanes.Keys1[lane] = pair.Key1;
+      lanes.Mins[lane] = pair.Mins;
+      lanes.Ranges[lane] = pair.Ranges;
+      alpha[lane] = pair.Alpha;
+    }
+    lanes.Alpha = _mm_loadu_ps(alpha);
+    return used;
+  }
+
+  // Decode and lerp translation keys four tracks at a time. out[idx] receives the value of pairs[idx]
+  void DecodeTranslations(AnimationCompressionFormat format, const std::vector<FKeyPair>& pairs, const std::vector<FVector*>& out)
+  {
+    const int32 count = (int32)pairs.size();
+    for (int32 first = 0; first < count; first += 4)
+    {
+      FBatchLanes lanes;
+      const int32 used = FillLanes(&pairs[first], count - first, lanes);
+      const FLanes t0 = DecodeTranslationLanes(format, lanes.Keys0, lanes.Mins, lanes.Ranges);
+      const FLanes t1 = DecodeTranslationLanes(format, lanes.Keys1, lanes.Mins, lanes.Ranges);
+      float x[4], y[4], z[4];
+      _mm_storeu_ps(x, _mm_add_ps(t0.X, _mm_mul_ps(_mm_sub_ps(t1.X, t0.X), lanes.Alpha)));
+      _mm_storeu_ps(y, _mm_add_ps(t0.Y, _mm_mul_ps(_mm_sub_ps(t1.Y, t0.Y), lanes.Alpha)));
+      _mm_storeu_ps(z, _mm_add_ps(t0.Z, _mm_mul_ps(_mm_sub_ps(t1.Z, t0.Z), lanes.Alpha)));
+      for (int32 lane = 0; lane < used; ++lane)
+      {
+        FVector* v = out[first + lane];
+        v->X = x[lane];
+        v->Y = y[lane];
+        v->Z = z[lane];
+      }
+    }
+  }
+
+  // Decode rotation keys four tracks at a time and blend them with a normalized lerp along the shortest arc
+  void DecodeRotations(AnimationCompressionFormat format, const std::vector<FKeyPair>& pairs, const std::vector<FQuat*>& out)
+  {
+    const int32 count = (int32)pairs.size();
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.f);
+    for (int32 first = 0; first < count; first += 4)
+    {
+      FBatchLanes lanes;
+      const int32 used = FillLanes(&pairs[first], count - first, lanes);
+      FLanes q0 = DecodeRotationLanes(format, lanes.Keys0, lanes.Mins, lanes.Ranges);
+      const FLanes q1 = DecodeRotationLanes(format, lanes.Keys1, lanes.Mins, lanes.Ranges);
+
+      __m128 dot = _mm_mul_ps(q0.X, q1.X);
+      dot = _mm_add_ps(dot, _mm_mul_ps(q0.Y, q1.Y));
+      dot = _mm_add_ps(dot, _mm_mul_ps(q0.Z, q1.Z));
+      dot = _mm_add_ps(dot, _mm_mul_ps(q0.W, q1.W));
+      // -1 where the keys are on opposite hemispheres, 1 otherwise
+      const __m128 negative = _mm_cmplt_ps(dot, zero);
+      const __m128 bias = _mm_or_ps(_mm_and_ps(negative, _mm_set1_ps(-1.f)), _mm_andnot_ps(negative, one));
+      const __m128 w0 = _mm_sub_ps(one, lanes.Alpha);
+      const __m128 w1 = _mm_mul_ps(lanes.Alpha, bias);
+      FLanes q;
+      q.X = _mm_add_ps(_mm_mul_ps(q0.X, w0), _mm_mul_ps(q1.X, w1));
+      q.Y = _mm_add_ps(_mm_mul_ps(q0.Y, w0), _mm_mul_ps(q1.Y, w1));
+      q.Z = _mm_add_ps(_mm_mul_ps(q0.Z, w0), _mm_mul_ps(q1.Z, w1));
+      q.W = _mm_add_ps(_mm_mul_ps(q0.W, w0), _mm_mul_ps(q1.W, w1));
+
+      __m128 lengthSq = _mm_mul_ps(q.X, q.X);
+      lengthSq = _mm_add_ps(lengthSq, _mm_mul_ps(q.Y, q.Y));
+      lengthSq = _mm_add_ps(lengthSq, _mm_mul_ps(q.Z, q.Z));
+      lengthSq = _mm_add_ps(lengthSq, _mm_mul_ps(q.W, q.W));
+      const __m128 length = _mm_sqrt_ps(lengthSq);
+      // Degenerate blends fall back to the first key
+      const __m128 valid = _mm_cmpgt_ps(length, _mm_set1_ps(1e-8f));
+      const __m128 divisor = _mm_or_ps(_mm_and_ps(valid, length), _mm_andnot_ps(valid, one));
+      q.X = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(q.X, divisor)), _mm_andnot_ps(valid, q0.X));
+      q.Y = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(q.Y, divisor)), _mm_andnot_ps(valid, q0.Y));
+      q.Z = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(q.Z, divisor)), _mm_andnot_ps(valid, q0.Z));
+      q.W = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(q.W, divisor)), _mm_andnot_ps(valid, q0.W));
+
+      _MM_TRANSPOSE4_PS(q.X, q.Y, q.Z, q.W);
+      const __m128 rows[4] = { q.X, q.Y, q.Z, q.W };
+      for (int32 lane = 0; lane < used; ++lane)
+      {
+        _mm_storeu_ps(&out[first + lane]->X, rows[lane]);
+      }
+    }
+  }
+}
 
 FStream& operator<<(FStream& s, FRawAnimSequenceTrack& t)
 {
@@ -74,6 +582,12 @@ bool UAnimSequence::RegisterProperty(FPropertyTag* property)
     TranslationCompressionFormatProperty = property;
     return true;
   }
+  if (PROP_IS(property, KeyEncodingFormat))
+  {
+    KeyEncodingFormat = (AnimationKeyFormat)property->Value->GetByte();
+    KeyEncodingFormatProperty = property;
+    return true;
+  }
   if (PROP_IS(property, bNoLoopingInterpolation))
   {
     bNoLoopingInterpolation = property->Value->GetBool();
@@ -86,6 +600,31 @@ bool UAnimSequence::RegisterProperty(FPropertyTag* property)
 void UAnimSequence::Serialize(FStream& s)
 {
   Super::Serialize(s);
+  if (s.IsReading() && s.GetPackage())
+  {
+    // Keys are read on demand. Walk the track headers to find the end of the raw data
+    RawAnimationDataOffset = s.GetPosition();
+    uint32 numTracks = 0;
+    s << numTracks;
+    for (uint32 idx = 0; idx < numTracks * 2; ++idx)
+    {
+      FILE_OFFSET elementSize = 0;
+      int32 numKeys = 0;
+      s << elementSize;
+      s << numKeys;
+      s.SetPosition(s.GetPosition() + elementSize * numKeys);
+    }
+    s << NumBytes;
+    SerializedDataOffset = s.GetPosition();
+    s.SetPosition(SerializedDataOffset + NumBytes);
+    return;
+  }
+  if (!s.IsReading())
+  {
+    std::scoped_lock<std::mutex> lock(DataMutex);
+    LoadRawAnimationData();
+    LoadSerializedData();
+  }
   s << RawAnimationData;
   s << NumBytes;
   if (s.IsReading())
@@ -95,3 +634,139 @@ void UAnimSequence::Serialize(FStream& s)
   }
   s.SerializeBytes(SerializedData, NumBytes);
 }
+
+const std::vector<FRawAnimSequenceTrack>& UAnimSequence::GetRawAnimationData()
+{
+  std::scoped_lock<std::mutex> lock(DataMutex);
+  LoadRawAnimationData();
+  return RawAnimationData;
+}
+
+bool UAnimSequence::SampleCompressedTracks(float time, int32 firstTrack, int32 count, FAnimTrackSample* out)
+{
+  if (firstTrack < 0 || count <= 0 || firstTrack + count > GetNumCompressedTracks() || KeyEncodingFormat == AKF_PerTrackCompression)
+  {
+    return false;
+  }
+
+  const FKeyCodec<FQuat> rotationCodec = GetRotationCodec(RotationCompressionFormat);
+  const FKeyCodec<FVector> translationCodec = GetTranslationCodec(TranslationCompressionFormat);
+  if (!rotationCodec.Decode || !translationCodec.Decode)
+  {
+    return false;
+  }
+  // Tracks with a single key are always stored uncompressed
+  const FKeyCodec<FQuat> singleRotationCodec = GetRotationCodec(ACF_Float96NoW);
+  const FKeyCodec<FVector> singleTranslationCodec = GetTranslationCodec(ACF_None);
+
+  std::scoped_lock<std::mutex> lock(DataMutex);
+  LoadSerializedData();
+  if (!SerializedData || NumBytes <= 0)
+  {
+    return false;
+  }
+
+  // Locate keys of every track first, then decode animated tracks in SIMD batches
+  std::vector<FKeyPair> translationPairs;
+  std::vector<FVector*> translationOut;
+  std::vector<FKeyPair> rotationPairs;
+  std::vector<FQuat*> rotationOut;
+  translationPairs.reserve(count);
+  translationOut.reserve(count);
+  rotationPairs.reserve(count);
+  rotationOut.reserve(count);
+
+  const bool variableKeys = KeyEncodingFormat == AKF_VariableKeyLerp;
+  const float relativePos = SequenceDuration > 0.f ? std::clamp(time / SequenceDuration, 0.f, 1.f) : 0.f;
+  for (int32 idx = 0; idx < count; ++idx)
+  {
+    const int32* offsets = &CompressedTrackOffsets[(firstTrack + idx) * 4];
+    FAnimTrackSample& sample = out[idx];
+    FKeyPair pair;
+
+    if (!offsets[1])
+    {
+      DecodeTranslationIdentity(nullptr, nullptr, nullptr, sample.Translation);
+    }
+    else if (offsets[1] == 1)
+    {
+      if (!LocateKeys(SerializedData, NumBytes, offsets[0], 1, singleTranslationCodec, false, NumFrames, relativePos, pair))
+      {
+        return false;
+      }
+      singleTranslationCodec.Decode(pair.Key0, nullptr, nullptr, sample.Translation);
+    }
+    else
+    {
+      if (!LocateKeys(SerializedData, NumBytes, offsets[0], offsets[1], translationCodec, variableKeys, NumFrames, relativePos, pair))
+      {
+        return false;
+      }
+      translationPairs.push_back(pair);
+      translationOut.push_back(&sample.Translation);
+    }
+
+    if (!offsets[3])
+    {
+      DecodeRotationIdentity(nullptr, nullptr, nullptr, sample.Rotation);
+    }
+    else if (offsets[3] == 1)
+    {
+      if (!LocateKeys(SerializedData, NumBytes, offsets[2], 1, singleRotationCodec, false, NumFrames, relativePos, pair))
+      {
+        return false;
+      }
+      singleRotationCodec.Decode(pair.Key0, nullptr, nullptr, sample.Rotation);
+    }
+    else
+    {
+      if (!LocateKeys(SerializedData, NumBytes, offsets[2], offsets[3], rotationCodec, variableKeys, NumFrames, relativePos, pair))
+      {
+        return false;
+      }
+      rotationPairs.push_back(pair);
+      rotationOut.push_back(&sample.Rotation);
+    }
+  }
+
+  DecodeTranslations(TranslationCompressionFormat, translationPairs, translationOut);
+  DecodeRotations(RotationCompressionFormat, rotationPairs, rotationOut);
+  return true;
+}
+
+void UAnimSequence::LoadRawAnimationData()
+{
+  if (RawAnimationDataOffset == INDEX_NONE)
+  {
+    return;
+  }
+  std::vector<FRawAnimSequenceTrack> data;
+  if (!GetPackage()->ReadDeferredData(RawAnimationDataOffset, [&](FStream& s) { s << data; }))
+  {
+    LogE("Failed to read raw animation data of %s", GetObjectName().C_str());
+    return;
+  }
+  RawAnimationData = std::move(data);
+}
+
+void UAnimSequence::LoadSerializedData()
+{
+  if (SerializedDataOffset == INDEX_NONE)
+  {
+    return;
+  }
+  if (NumBytes <= 0)
+  {
+    SerializedDataOffset = INDEX_NONE;
+    return;
+  }
+  uint8* data = (uint8*)malloc(NumBytes);
+  if (!GetPackage()->ReadDeferredData(SerializedDataOffset, [&](FStream& s) { s.SerializeBytes(data, NumBytes); }))
+  {
+    free(data);
+    LogE("Failed to read compressed animation data of %s", GetObjectName().C_str());
+    return;
+  }
+  free(SerializedData);
+  SerializedData = data;
+}
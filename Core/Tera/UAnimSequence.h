@@ -2,6 +2,8 @@
 #include "UObject.h"
 #include "FStream.h"
 
+#include <mutex>
+
 struct FRawAnimSequenceTrack {
   std::vector<FVector> PosKeys;
   std::vector<FQuat> RotKeys;
@@ -11,6 +13,12 @@ struct FRawAnimSequenceTrack {
   FILE_OFFSET RotKeysElementSize = sizeof(FQuat);
 };
 
+// Bone transform decoded from a compressed track
+struct FAnimTrackSample {
+  FVector Translation;
+  FQuat Rotation;
+};
+
 class UAnimSequence : public UObject {
 public:
   DECL_UOBJ(UAnimSequence, UObject);
@@ -27,13 +35,37 @@ public:
   UPROP(std::vector<int>, CompressedTrackOffsets, {});
   UPROP(AnimationCompressionFormat, RotationCompressionFormat, ACF_None);
   UPROP(AnimationCompressionFormat, TranslationCompressionFormat, ACF_None);
+  UPROP(AnimationKeyFormat, KeyEncodingFormat, AKF_ConstantKeyLerp);
 
   bool RegisterProperty(FPropertyTag* property) override;
 
   void Serialize(FStream& s) override;
 
+  // Raw keys are read from the package on the first call
+  const std::vector<FRawAnimSequenceTrack>& GetRawAnimationData();
+
+  inline int32 GetNumCompressedTracks() const
+  {
+    return (int32)CompressedTrackOffsets.size() / 4;
+  }
+
+  // Decode compressed tracks [firstTrack, firstTrack + count) at the time in seconds.
+  // Animated tracks are decoded with SSE2, four tracks per step.
+  // out must have room for count samples. Returns false if the tracks can't be decoded.
+  bool SampleCompressedTracks(float time, int32 firstTrack, int32 count, FAnimTrackSample* out);
+
+protected:
+  // Read deferred data. Caller must hold DataMutex
+  void LoadRawAnimationData();
+  void LoadSerializedData();
+
 protected:
   std::vector<FRawAnimSequenceTrack> RawAnimationData;
   int32 NumBytes = 0;
   uint8* SerializedData = nullptr;
+
+  // Positions of the data skipped during loading
+  FILE_OFFSET RawAnimationDataOffset = INDEX_NONE;
+  FILE_OFFSET SerializedDataOffset = INDEX_NONE;
+  std::mutex DataMutex;
 };
\ No newline at end of file
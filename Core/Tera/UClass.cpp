@@ -68,6 +68,13 @@ void UStruct::Link()
   {
     it->Link();
   }
+  if (Ancestry.empty())
+  {
+    for (const UStruct* s = this; s; s = s->GetSuperStruct())
+    {
+      Ancestry.insert(Ancestry.begin(), s);
+    }
+  }
   if (!PropertyLink)
   {
     UProperty** propertyLinkPtr = &PropertyLink;
@@ -360,7 +367,7 @@ void UStruct::SerializeBinProperty(UProperty* property, FPropertyValue* value, F
 
 void UClass::CreateBuiltInClasses(FPackage* package)
 {
-#define MAKE_CLASS(NAME) exp = package->CreateVirtualExport(##NAME, NAME_Class); exp->SetObject(new UClass(exp, true)); obj = (UClass*)exp->GetObject(); obj->Loaded = true; FPackage::RegisterClass((UClass*)obj)
+#define MAKE_CLASS(NAME) exp = package->CreateVirtualExport(##NAME, NAME_Class); exp->SetObject(new UClass(exp, true)); obj = (UClass*)exp->GetObject(); obj->LoadState = ObjectLoadState::Loaded; FPackage::RegisterClass((UClass*)obj)
   const auto pkgName = package->GetPackageName();
   VObjectExport* exp = nullptr;
   UClass* obj = nullptr;
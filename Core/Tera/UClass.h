@@ -140,6 +140,12 @@ public:
 
   inline bool IsChildOf(const UStruct* SomeBase) const
   {
+    if (Ancestry.size() && SomeBase && SomeBase->Ancestry.size())
+    {
+      // Ancestry is root first, so a parent must be at its own depth
+      const size_t depth = SomeBase->Ancestry.size() - 1;
+      return depth < Ancestry.size() && Ancestry[depth] == SomeBase;
+    }
     for (const UStruct* Struct = this; Struct; Struct = Struct->GetSuperStruct())
     {
       if (Struct == SomeBase)
@@ -201,6 +207,8 @@ protected:
   void* ScriptData = nullptr;
   void* ScriptStorage = nullptr;
   UProperty* PropertyLink = nullptr;
+  // Super chain from the root to this struct. Built by Link
+  std::vector<const UStruct*> Ancestry;
 };
 
 class UState : public UStruct {
@@ -210,7 +218,7 @@ public:
 
   UState* GetSuperState() const
   {
-    DBreakIf(SuperStruct && !SuperStruct->IsA(UState::StaticClassName()));
+    DBreakIf(SuperStruct && !SuperStruct->IsA<UState>());
     return (UState*)SuperStruct;
   }
 
@@ -2,6 +2,9 @@
 #include "FPackage.h"
 #include "Cast.h"
 
+#include <atomic>
+#include <ppl.h>
+
 bool ULevelStreaming::RegisterProperty(FPropertyTag* property)
 {
   if (Super::RegisterProperty(property))
@@ -99,6 +102,39 @@ retry:
   }
 }
 
+void ULevelStreaming::LoadStreamingLevels(const std::vector<ULevelStreaming*>& levels, std::function<void(ULevelStreaming*, int32)> onLoaded)
+{
+  // Sublevels import the same shared packages. This is safe because FPackage::Load is single-flight:
+  // a level that resolves a package another worker is still reading waits for its tables.
+  // UObject::Load opens a separate stream per object, so objects of one package load concurrently.
+  std::atomic<int32> loaded = 0;
+  concurrency::parallel_for(size_t(0), levels.size(), [&](size_t idx) {
+    ULevelStreaming* streaming = levels[idx];
+    if (!streaming)
+    {
+      return;
+    }
+    try
+    {
+      streaming->Load();
+      if (streaming->Level)
+      {
+        // Pull in actors and their components while we are still on the worker thread
+        streaming->Level->GetActors();
+      }
+    }
+    catch (const std::exception& e)
+    {
+      LogE("Failed to load streaming level %s: %s", streaming->PackageName.C_str(), e.what());
+    }
+    const int32 count = ++loaded;
+    if (onLoaded)
+    {
+      onLoaded(streaming, count);
+    }
+  });
+}
+
 bool ULevelStreamingVolume::RegisterProperty(FPropertyTag* property)
 {
   if (Super::RegisterProperty(property))
@@ -2,6 +2,8 @@
 #include "UObject.h"
 #include "ULevel.h"
 
+#include <functional>
+
 class ULevelStreaming : public UObject {
 public:
   DECL_UOBJ(ULevelStreaming, UObject);
@@ -10,6 +12,11 @@ public:
   bool RegisterProperty(FPropertyTag* property) override;
   void PostLoad() override;
 
+  // Load streaming levels, their packages and actors concurrently.
+  // onLoaded is called from a worker thread in completion order, not in input order, with the number of completed levels.
+  // Level pointers are valid only after this function returns.
+  static void LoadStreamingLevels(const std::vector<ULevelStreaming*>& levels, std::function<void(ULevelStreaming*, int32)> onLoaded = nullptr);
+
   ULevel* Level = nullptr;
 };
 
@@ -66,6 +66,36 @@ void FMaterial::Serialize(FStream& s)
   s << Unk3;
 }
 
+namespace
+{
+  // Calls func(name, valueTag) for each {ParameterName, ParameterValue} struct of the array
+  template <typename TFunc>
+  void ForEachParameterValue(const std::vector<FPropertyValue*>& values, TFunc func)
+  {
+    for (FPropertyValue* container : values)
+    {
+      FPropertyTag* nameTag = nullptr;
+      FPropertyTag* valueTag = nullptr;
+      for (FPropertyValue* subcontainer : container->GetArray())
+      {
+        FPropertyTag* tmpTag = subcontainer->GetPropertyTagPtr();
+        if (tmpTag->Name == "ParameterName")
+        {
+          nameTag = tmpTag;
+        }
+        else if (tmpTag->Name == "ParameterValue")
+        {
+          valueTag = tmpTag;
+        }
+      }
+      if (nameTag && valueTag)
+      {
+        func(nameTag->Value->GetName().String(), valueTag);
+      }
+    }
+  }
+}
+
 bool UMaterialInterface::RegisterProperty(FPropertyTag* property)
 {
   if (PROP_IS(property, TextureParameterValues))
@@ -74,6 +104,18 @@ bool UMaterialInterface::RegisterProperty(FPropertyTag* property)
     TextureParameterValuesProperty = property;
     return true;
   }
+  if (PROP_IS(property, ScalarParameterValues))
+  {
+    ScalarParameterValues = property->Value->GetArray();
+    ScalarParameterValuesProperty = property;
+    return true;
+  }
+  if (PROP_IS(property, VectorParameterValues))
+  {
+    VectorParameterValues = property->Value->GetArray();
+    VectorParameterValuesProperty = property;
+    return true;
+  }
   if (PROP_IS(property, BlendMode))
   {
     BlendMode = (EBlendMode)property->Value->GetByte();
@@ -101,53 +143,116 @@ UTexture2D* UMaterialInterface::GetDiffuseTexture() const
 
 EBlendMode UMaterialInterface::GetBlendMode() const
 {
-  if (BlendModeProperty)
+  return GetParameterTable()->BlendMode;
+}
+
+UObject* UMaterialInterface::GetParent() const
+{
+  return ParentProperty ? GetPackage()->GetObject(Parent) : nullptr;
+}
+
+std::atomic<uint32> UMaterialInterface::ParameterTablesEpoch = { 1 };
+
+std::shared_ptr<const FMaterialParameterTable> UMaterialInterface::GetParameterTable() const
+{
+  std::scoped_lock<std::recursive_mutex> l(ParameterTableMutex);
+  const uint32 epoch = ParameterTablesEpoch.load();
+  if (ParameterTableBuilding || (ParameterTable && ParameterTableEpoch == epoch))
   {
-    return BlendMode;
+    // A broken package may reference itself through the Parent chain. Don't recurse
+    return ParameterTable ? ParameterTable : std::make_shared<const FMaterialParameterTable>();
   }
-  UMaterialInterface* parent = Cast<UMaterialInterface>(GetParent());
-  while (parent)
+  ParameterTableBuilding = true;
+  std::shared_ptr<FMaterialParameterTable> table = std::make_shared<FMaterialParameterTable>();
+  try
   {
-    if (parent->BlendModeProperty)
+    UMaterialInterface* parent = Cast<UMaterialInterface>(GetParent());
+    if (parent && parent != this)
     {
-      return parent->GetBlendMode();
+      *table = *parent->GetParameterTable();
     }
-    parent = Cast<UMaterialInterface>(parent->GetParent());
+    BuildParameterTable(*table);
   }
-  return BlendMode;
+  catch (...)
+  {
+    ParameterTableBuilding = false;
+    throw;
+  }
+  ParameterTableBuilding = false;
+  ParameterTable = table;
+  // Store the epoch read before the build. A change made meanwhile triggers another rebuild
+  ParameterTableEpoch = epoch;
+  return ParameterTable;
 }
 
-UObject* UMaterialInterface::GetParent() const
+void UMaterialInterface::InvalidateParameterTables()
 {
-  return ParentProperty ? GetPackage()->GetObject(Parent) : nullptr;
+  ParameterTablesEpoch++;
 }
 
-UTexture2D* UMaterialInterface::GetTextureParameterValue(const FString& name) const
+void UMaterialInterface::MarkDirty(bool dirty)
 {
-  bool thisValue = false;
-  for (FPropertyValue* container : TextureParameterValues)
+  Super::MarkDirty(dirty);
+  if (!dirty)
   {
-    std::vector<FPropertyValue*>& tmpArray = container->GetArray();
-    for (FPropertyValue* subcontainer : tmpArray)
+    return;
+  }
+  if (TextureParameterValuesProperty)
+  {
+    TextureParameterValues = TextureParameterValuesProperty->Value->GetArray();
+  }
+  if (ScalarParameterValuesProperty)
+  {
+    ScalarParameterValues = ScalarParameterValuesProperty->Value->GetArray();
+  }
+  if (VectorParameterValuesProperty)
+  {
+    VectorParameterValues = VectorParameterValuesProperty->Value->GetArray();
+  }
+  if (BlendModeProperty)
+  {
+    BlendMode = (EBlendMode)BlendModeProperty->Value->GetByte();
+  }
+  if (ParentProperty)
+  {
+    Parent = ParentProperty->Value->GetObjectIndex();
+  }
+  InvalidateParameterTables();
+}
+
+void UMaterialInterface::BuildParameterTable(FMaterialParameterTable& table) const
+{
+  if (BlendModeProperty || !ParentProperty)
+  {
+    table.BlendMode = BlendMode;
+  }
+  ForEachParameterValue(TextureParameterValues, [&](const FString& name, FPropertyTag* value) {
+    if (PACKAGE_INDEX objIndex = value->Value->GetObjectIndex())
     {
-      FPropertyTag* tmpTag = subcontainer->GetPropertyTagPtr();
-      if (tmpTag->Name == "ParameterName" && tmpTag->Value->GetName() == name)
-      {
-        thisValue = true;
-        continue;
-      }
-      else if (thisValue && tmpTag->Name == "ParameterValue")
-      {
-        PACKAGE_INDEX objIndex = tmpTag->Value->GetObjectIndex();
-        thisValue = false;
-        if (objIndex)
-        {
-          return Cast<UTexture2D>(GetPackage()->GetObject(objIndex));
-        }
-      }
+      table.Textures[name] = { this, objIndex };
+    }
+  });
+  ForEachParameterValue(ScalarParameterValues, [&](const FString& name, FPropertyTag* value) {
+    table.Scalars[name] = value->Value->GetFloat();
+  });
+  ForEachParameterValue(VectorParameterValues, [&](const FString& name, FPropertyTag* value) {
+    FLinearColor color;
+    if (value->GetLinearColor(color))
+    {
+      table.Vectors[name] = color;
     }
+  });
+}
+
+UTexture2D* UMaterialInterface::GetTextureParameterValue(const FString& name) const
+{
+  std::shared_ptr<const FMaterialParameterTable> table = GetParameterTable();
+  auto it = table->Textures.find(name);
+  if (it == table->Textures.end())
+  {
+    return nullptr;
   }
-  return nullptr;
+  return Cast<UTexture2D>(it->second.Owner->GetPackage()->GetObject(it->second.Index));
 }
 
 void UMaterial::Serialize(FStream& s)
@@ -213,4 +318,13 @@ bool UMaterialInstance::RegisterProperty(FPropertyTag* property)
     return true;
   }
   return false;
+}
+
+void UMaterialInstance::BuildParameterTable(FMaterialParameterTable& table) const
+{
+  Super::BuildParameterTable(table);
+  for (const FStaticSwitchParameter& param : StaticParameters.StaticSwitchParameters)
+  {
+    table.StaticSwitches[param.ParameterName.String()] = param.Value;
+  }
 }
\ No newline at end of file
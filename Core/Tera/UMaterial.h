@@ -1,6 +1,10 @@
 #pragma once
 #include "UObject.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 class UTexture2D;
 class UMaterialExpression;
 
@@ -87,21 +91,62 @@ struct FStaticParameterSet {
   friend FStream& operator<<(FStream& s, FStaticParameterSet& ps);
 };
 
+// Material parameters merged down the parent chain
+struct FMaterialParameterTable {
+  struct TextureValue {
+    // Material that defines the value. Used to resolve the index
+    const class UMaterialInterface* Owner = nullptr;
+    PACKAGE_INDEX Index = INDEX_NONE;
+  };
+
+  FStringMap<TextureValue> Textures;
+  FStringMap<float> Scalars;
+  FStringMap<FLinearColor> Vectors;
+  FStringMap<bool> StaticSwitches;
+  EBlendMode BlendMode = EBlendMode::BLEND_Opaque;
+};
+
 class UMaterialInterface : public UObject {
 public:
   DECL_UOBJ(UMaterialInterface, UObject);
 
   bool RegisterProperty(FPropertyTag* property) override;
 
+  // Property edits change tags in place. Refresh cached values and invalidate parameter tables
+  void MarkDirty(bool dirty = true) override;
+
   UTexture2D* GetTextureParameterValue(const FString& name) const;
   UTexture2D* GetDiffuseTexture() const;
   EBlendMode GetBlendMode() const;
   UObject* GetParent() const;
 
+  // Parameters of this material and all its parents. Built on first access and rebuilt after any material changes.
+  // Returns a snapshot, so a concurrent rebuild never changes a table that is in use
+  std::shared_ptr<const FMaterialParameterTable> GetParameterTable() const;
+
+  // Mark parameter tables of all materials stale. Children copy their parent's values, so a change may affect any of them
+  static void InvalidateParameterTables();
+
+protected:
+  // Add own values on top of the parent's table
+  virtual void BuildParameterTable(FMaterialParameterTable& table) const;
+
 protected:
   UPROP(std::vector<FPropertyValue*>, TextureParameterValues, {});
+  UPROP(std::vector<FPropertyValue*>, ScalarParameterValues, {});
+  UPROP(std::vector<FPropertyValue*>, VectorParameterValues, {});
   UPROP(EBlendMode, BlendMode, EBlendMode::BLEND_Opaque);
   UPROP(PACKAGE_INDEX, Parent, INDEX_NONE);
+
+private:
+  mutable std::shared_ptr<const FMaterialParameterTable> ParameterTable;
+  mutable std::recursive_mutex ParameterTableMutex;
+  mutable bool ParameterTableBuilding = false;
+  // Value of ParameterTablesEpoch the table was built at
+  mutable uint32 ParameterTableEpoch = 0;
+
+  // Bumped by InvalidateParameterTables
+  static std::atomic<uint32> ParameterTablesEpoch;
 };
 
 class UMaterial : public UMaterialInterface {
@@ -130,6 +175,9 @@ public:
 
   FMaterial StaticPermutationResource;
   FStaticParameterSet StaticParameters;
+
+protected:
+  void BuildParameterTable(FMaterialParameterTable& table) const override;
 };
 
 class UMaterialInstanceConstant : public UMaterialInstance {
@@ -7,10 +7,41 @@
 
 #include "ALog.h"
 
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <ppl.h>
+
 #if DUMP_OBJECTS
 #include <filesystem>
 #endif
 
+namespace
+{
+  std::mutex LoadWaitMutex;
+  std::condition_variable LoadWaitCondition;
+  // Objects the threads are waiting for. Used to detect wait cycles between threads
+  std::unordered_map<std::thread::id, const UObject*> LoadWaits;
+  std::atomic<int32> LoadWaitersCount = { 0 };
+
+  // Class names are string literals, so views stay valid.
+  // Function statics: classes may be registered during static initialization
+  std::mutex& GetNativeClassesMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  std::unordered_map<std::string_view, uint32>& GetNativeClassIds()
+  {
+    static std::unordered_map<std::string_view, uint32> ids;
+    return ids;
+  }
+}
+
 UObject::UObject(FObjectExport* exp)
   : Export(exp)
 {
@@ -94,7 +125,8 @@ void* UObject::GetRawData()
   {
     return RawData;
   }
-  FReadStream s(GetPackage()->GetDataPath());
+  std::unique_ptr<FStream> stream = GetPackage()->CreateDataStream();
+  FStream& s = *stream;
   if (!RawDataOffset)
   {
     try
@@ -243,7 +275,7 @@ void UObject::Serialize(FStream& s)
     }
   }
 
-  if (IsA(UComponent::StaticClassName()))
+  if (IsA<UComponent>())
   {
     ((UComponent*)this)->PreSerialize(s);
   }
@@ -292,77 +324,129 @@ void UObject::Load()
     return;
   }
   // Create a new stream here. This allows safe multithreading
-  FReadStream s = FReadStream(A2W(GetPackage()->GetDataPath()));
-  s.SetPackage(GetPackage());
-  s.SetLoadSerializedObjects(GetPackage()->GetStream().GetLoadSerializedObjects());
+  std::unique_ptr<FStream> s = GetPackage()->CreateDataStream();
+  s->SetLoadSerializedObjects(GetPackage()->GetStream().GetLoadSerializedObjects());
 
-  Load(s);
+  Load(*s);
 }
 
-void UObject::Load(FStream& s)
+void UObject::WaitForLoad() const
 {
-  if (Loaded || Loading)
+  const std::thread::id self = std::this_thread::get_id();
+  if (LoadingThread.load() == self)
   {
     return;
   }
-  Loading = true;
+  std::unique_lock<std::mutex> lock(LoadWaitMutex);
+  // Follow the chain of waiting threads. If it leads back to this thread nobody would ever wake up.
+  const UObject* waitee = this;
+  for (size_t depth = 0; waitee && depth <= LoadWaits.size(); ++depth)
+  {
+    const std::thread::id owner = waitee->LoadingThread.load();
+    if (owner == self)
+    {
+      return;
+    }
+    auto it = LoadWaits.find(owner);
+    waitee = it == LoadWaits.end() ? nullptr : it->second;
+  }
+  LoadWaits[self] = this;
+  LoadWaitersCount++;
+  LoadWaitCondition.wait(lock, [this] { return LoadState.load() != ObjectLoadState::Loading; });
+  LoadWaitersCount--;
+  LoadWaits.erase(self);
+}
 
-  // Load object's class and a default object
-  if (GetClassName() != UClass::StaticClassName())
+void UObject::FinishLoad(ObjectLoadState state)
+{
+  LoadingThread = std::thread::id();
+  LoadState = state;
+  // Waiters check the state under the lock. Taking it guarantees they are either asleep or will see the new state
+  if (LoadWaitersCount.load())
   {
-    Class = GetPackage()->LoadClass(Export->ClassIndex);
-    bool isNative = HasAnyFlags(RF_Native);
-    PACKAGE_INDEX outerIndex = Export->OuterIndex;
-    while (outerIndex && !isNative)
     {
-      FObjectExport* outer = GetPackage()->GetExportObject(outerIndex);
-      isNative = outer->ObjectFlags & RF_Native;
-      outerIndex = outer->OuterIndex;
+      std::scoped_lock<std::mutex> lock(LoadWaitMutex);
     }
-    if (!isNative)
+    LoadWaitCondition.notify_all();
+  }
+}
+
+void UObject::Load(FStream& s)
+{
+  ObjectLoadState expected = ObjectLoadState::Unloaded;
+  if (!LoadState.compare_exchange_strong(expected, ObjectLoadState::Loading))
+  {
+    if (expected == ObjectLoadState::Loading)
     {
-      if (Class && !HasAnyFlags(RF_ClassDefaultObject))
-      {
-        DefaultObject = Class->GetClassDefaultObject();
-      }
+      WaitForLoad();
     }
+    return;
   }
+  LoadingThread = std::this_thread::get_id();
 
-  if (s.IsReading())
+  try
   {
-    s.SetPosition(Export->SerialOffset);
+    // Load object's class and a default object
+    if (GetClassName() != UClass::StaticClassName())
+    {
+      Class = GetPackage()->LoadClass(Export->ClassIndex);
+      bool isNative = HasAnyFlags(RF_Native);
+      PACKAGE_INDEX outerIndex = Export->OuterIndex;
+      while (outerIndex && !isNative)
+      {
+        FObjectExport* outer = GetPackage()->GetExportObject(outerIndex);
+        isNative = outer->ObjectFlags & RF_Native;
+        outerIndex = outer->OuterIndex;
+      }
+      if (!isNative)
+      {
+        if (Class && !HasAnyFlags(RF_ClassDefaultObject))
+        {
+          DefaultObject = Class->GetClassDefaultObject();
+        }
+      }
+    }
+
+    if (s.IsReading())
+    {
+      s.SetPosition(Export->SerialOffset);
 #if DUMP_OBJECTS
-    void* data = malloc(Export->SerialSize);
-    s.SerializeBytes(data, Export->SerialSize);
-    s.SetPosition(Export->SerialOffset);
-    std::filesystem::path path = std::filesystem::path(DUMP_PATH) / GetPackage()->GetPackageName().String() / "Objects";
-    std::filesystem::create_directories(path);
-    path /= (Export->GetFullObjectName().String() + ".bin");
-    std::ofstream os(path.wstring(), std::ios::out | std::ios::binary);
-    os.write((const char*)data, Export->SerialSize);
-    free(data);
+      void* data = malloc(Export->SerialSize);
+      s.SerializeBytes(data, Export->SerialSize);
+      s.SetPosition(Export->SerialOffset);
+      std::filesystem::path path = std::filesystem::path(DUMP_PATH) / GetPackage()->GetPackageName().String() / "Objects";
+      std::filesystem::create_directories(path);
+      path /= (Export->GetFullObjectName().String() + ".bin");
+      std::ofstream os(path.wstring(), std::ios::out | std::ios::binary);
+      os.write((const char*)data, Export->SerialSize);
+      free(data);
 #endif
-  }
-  
+    }
+    
 #if SERIALIZE_PROPERTIES
-  if (HasAnyFlags(RF_ClassDefaultObject))
-  {
-    SerializeDefaultObject(s);
-  }
-  else
-  {
-    Serialize(s);
-  }
+    if (HasAnyFlags(RF_ClassDefaultObject))
+    {
+      SerializeDefaultObject(s);
+    }
+    else
+    {
+      Serialize(s);
+    }
 #endif
 
-  Loaded = true;
-  Loading = false;
-
-  if (s.IsReading())
+    if (s.IsReading())
+    {
+      //DBreakIf(s.GetPosition() != Export->SerialOffset + Export->SerialSize);
+      PostLoad();
+    }
+  }
+  catch (...)
   {
-    //DBreakIf(s.GetPosition() != Export->SerialOffset + Export->SerialSize);
-    PostLoad();
+    FinishLoad(ObjectLoadState::Failed);
+    throw;
   }
+  // Other threads see the object as loaded only after PostLoad
+  FinishLoad(ObjectLoadState::Loaded);
 }
 
 void UObject::PostLoad()
@@ -402,33 +486,131 @@ void UObject::SerializeTrailingData(FStream& s)
   s.SerializeBytes(TrailingData, TrailingDataSize);
 }
 
-bool UObject::IsA(const char* base) const
+uint32 UObject::RegisterNativeClass(const char* className)
 {
-  const auto thisClassName = GetStaticClassName();
-  if (base == thisClassName)
+  std::scoped_lock<std::mutex> lock(GetNativeClassesMutex());
+  auto& ids = GetNativeClassIds();
+  auto it = ids.find(className);
+  if (it != ids.end())
+  {
+    return it->second;
+  }
+  if (ids.size() >= MAX_NATIVE_CLASSES)
   {
-    return true;
+    UThrow("Too many native classes. Increase MAX_NATIVE_CLASSES!");
   }
-  for (UClass* tmp = Class; tmp; tmp = static_cast<UClass*>(tmp->GetSuperStruct()))
+  const uint32 id = (uint32)ids.size();
+  ids[className] = id;
+  return id;
+}
+
+UObject* FObjectRef::Get() const
+{
+  if (!Resolved)
+  {
+    // Resolution is idempotent. Threads that race here get the same object
+    UObject* obj = Package ? Package->GetObject(Index) : nullptr;
+    Object = obj;
+    Resolved = true;
+    return obj;
+  }
+  return Object;
+}
+
+FStream& operator<<(FStream& s, FObjectRef& ref)
+{
+  if (s.IsReading())
+  {
+    ref.Package = s.GetPackage();
+    ref.Object = nullptr;
+    s << ref.Index;
+    ref.Resolved = !ref.Index;
+  }
+  else if (!ref.Resolved && ref.Package == s.GetPackage())
+  {
+    s << ref.Index;
+  }
+  else
+  {
+    PACKAGE_INDEX idx = s.GetPackage()->GetObjectIndex(ref.Get());
+    s << idx;
+  }
+  return s;
+}
+
+void UObject::Prefetch(const std::vector<UObject*>& objects, int32 depth)
+{
+  std::function<void(FPropertyValue*, std::vector<UObject*>&)> collect = [&](FPropertyValue* value, std::vector<UObject*>& output) {
+    if (!value || !value->Data)
+    {
+      return;
+    }
+    switch (value->Type)
+    {
+    case FPropertyValue::VID::Object:
+      if (UObject* obj = value->GetObjectValuePtr(false))
+      {
+        output.push_back(obj);
+      }
+      break;
+    case FPropertyValue::VID::Property:
+      collect(value->GetPropertyTag().Value, output);
+      break;
+    case FPropertyValue::VID::Field:
+    case FPropertyValue::VID::Struct:
+    case FPropertyValue::VID::Array:
+      for (FPropertyValue* item : value->GetArray())
+      {
+        collect(item, output);
+      }
+      break;
+    default:
+      break;
+    }
+  };
+
+  std::unordered_set<UObject*> visited;
+  std::vector<UObject*> wave;
+  for (UObject* obj : objects)
   {
-    if (base == tmp->GetStaticClassName())
+    if (obj && visited.insert(obj).second)
     {
-      return true;
+      wave.push_back(obj);
     }
   }
-  std::string chain = GetStaticClassChain();
-  size_t pos = chain.size();
-  size_t lastPos = pos;
-  while ((pos = chain.find_last_of('.', pos)) != std::string::npos)
+
+  for (int32 level = 0; wave.size() && (depth < 0 || level <= depth); ++level)
   {
-    if (std::string_view(chain.c_str() + pos + 1, lastPos - pos - 1) == base)
+    std::vector<std::vector<UObject*>> references(wave.size());
+    concurrency::parallel_for(size_t(0), wave.size(), [&](size_t idx) {
+      UObject* obj = wave[idx];
+      try
+      {
+        obj->Load();
+      }
+      catch (const std::exception& e)
+      {
+        LogE("Failed to prefetch %s: %s", obj->GetFullObjectName().C_str(), e.what());
+        return;
+      }
+      for (FPropertyTag* tag : obj->Properties)
+      {
+        collect(tag->Value, references[idx]);
+      }
+    });
+
+    wave.clear();
+    for (const std::vector<UObject*>& refs : references)
     {
-      return true;
+      for (UObject* obj : refs)
+      {
+        if (visited.insert(obj).second)
+        {
+          wave.push_back(obj);
+        }
+      }
     }
-    lastPos = pos;
-    pos--;
   }
-  return false;
 }
 
 FStream& operator<<(FStream& s, UObject*& obj)
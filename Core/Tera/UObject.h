@@ -3,6 +3,15 @@
 #include "FStream.h"
 #include "FPropertyTag.h"
 
+#include <atomic>
+#include <bitset>
+#include <thread>
+
+// Max number of native UObject classes
+#define MAX_NATIVE_CLASSES 256
+// Bit per native class: the class itself and all of its native parents
+typedef std::bitset<MAX_NATIVE_CLASSES> FClassAncestry;
+
 // Common UObject subclass declarations
 #define DECL_UOBJ(TClass, TSuper)\
 public:\
@@ -11,7 +20,9 @@ public:\
   typedef TSuper Super;\
   static const char* StaticClassName() { return ((char*)#TClass) + 1; }\
   const char* GetStaticClassName() const override { return ThisClass::StaticClassName(); }\
-  std::string GetStaticClassChain() const override { return Super::GetStaticClassChain() + "." + ThisClass::StaticClassName(); }\
+  static uint32 StaticClassId() { static const uint32 id = UObject::RegisterNativeClass(StaticClassName()); return id; }\
+  static const FClassAncestry& StaticAncestry() { static const FClassAncestry ancestry = UObject::MakeAncestry(Super::StaticAncestry(), StaticClassId()); return ancestry; }\
+  const FClassAncestry& GetStaticAncestry() const override { return ThisClass::StaticAncestry(); }\
   using TSuper::TSuper
 
 #define __GLUE_PROP(TName, Suffix) TName##Suffix
@@ -85,6 +96,14 @@ if (Super::RegisterProperty(property))\
 }\
 //
 
+enum class ObjectLoadState : uint8
+{
+  Unloaded = 0,
+  Loading,
+  Loaded,
+  Failed
+};
+
 class UObject {
 public:
   enum { StaticClassCastFlags = CASTCLASS_None };
@@ -104,6 +123,11 @@ public:
   // Object factory
   static UObject* Object(FObjectExport* exp);
 
+  // Load objects and everything they reference through properties, wave by wave on all cores.
+  // depth limits how many references deep to go. INDEX_NONE loads the whole closure.
+  // Imports are resolved on worker threads too. FPackage::Load makes concurrent opens of a shared package wait for its tables.
+  static void Prefetch(const std::vector<UObject*>& objects, int32 depth = INDEX_NONE);
+
   // Cpp class name. Use ONLY with a class (e.g. UObject::StaticClass())
   static const char* StaticClassName()
   {
@@ -120,14 +144,37 @@ public:
     return StaticClassName();
   }
 
-  virtual std::string GetStaticClassChain() const
+  // Native class id. Ids are assigned once, on the first use of a class
+  static uint32 StaticClassId()
   {
-    return StaticClassName();
+    static const uint32 id = RegisterNativeClass(StaticClassName());
+    return id;
+  }
+
+  static const FClassAncestry& StaticAncestry()
+  {
+    static const FClassAncestry ancestry = MakeAncestry(FClassAncestry(), StaticClassId());
+    return ancestry;
+  }
+
+  virtual const FClassAncestry& GetStaticAncestry() const
+  {
+    return StaticAncestry();
+  }
+
+  static uint32 RegisterNativeClass(const char* className);
+
+  static FClassAncestry MakeAncestry(const FClassAncestry& superAncestry, uint32 classId)
+  {
+    FClassAncestry result = superAncestry;
+    result.set(classId);
+    return result;
   }
 
   virtual ~UObject();
 
-  // Load the object from its package
+  // Load the object from its package. Thread-safe: if another thread is loading the object
+  // the call waits for it to finish. Nested calls from the loading thread return immediately.
   virtual void Load();
   virtual void Load(FStream& s);
 
@@ -177,7 +224,7 @@ public:
     return Inner;
   }
 
-  void MarkDirty(bool dirty = true);
+  virtual void MarkDirty(bool dirty = true);
 
   inline bool IsDirty() const
   {
@@ -210,7 +257,7 @@ public:
     T* result = NULL;
     for (UObject* nextOuter = Outer; result == NULL && nextOuter != NULL; nextOuter = nextOuter->GetOuter())
     {
-      if (nextOuter->IsA(T::StaticClassName()))
+      if (nextOuter->IsA<T>())
       {
         result = (T*)nextOuter;
       }
@@ -218,11 +265,20 @@ public:
     return result;
   }
 
-  bool IsA(const char* base) const;
+  template<typename T>
+  inline bool IsA() const
+  {
+    return GetStaticAncestry().test(T::StaticClassId());
+  }
 
   inline bool IsLoaded() const
   {
-    return Loaded;
+    return LoadState == ObjectLoadState::Loaded;
+  }
+
+  inline ObjectLoadState GetLoadState() const
+  {
+    return LoadState;
   }
 
   inline UClass* GetClass() const
@@ -272,8 +328,11 @@ protected:
 
   void SerializeTrailingData(FStream& s);
 
+  // Wait for a load started by another thread. Returns immediately if waiting would deadlock
+  void WaitForLoad() const;
+
 protected:
-  bool Loaded = false;
+  std::atomic<ObjectLoadState> LoadState = { ObjectLoadState::Unloaded };
   FObjectExport* Export = nullptr;
   FStateFrame* StateFrame = nullptr;
   NET_INDEX NetIndex = INDEX_NONE;
@@ -296,5 +355,106 @@ protected:
   std::string Description;
 #endif
 private:
-  bool Loading = false;
-};
\ No newline at end of file
+  void FinishLoad(ObjectLoadState state);
+
+private:
+  std::atomic<std::thread::id> LoadingThread;
+};
+
+// A reference to an object that is resolved and loaded on first access.
+// Holding one doesn't load the object or its package, so loading an owner costs only its own I/O.
+class FObjectRef {
+public:
+  FObjectRef()
+  {}
+
+  FObjectRef(UObject* object)
+    : Object(object)
+  {}
+
+  FObjectRef(FPackage* package, PACKAGE_INDEX index)
+    : Package(package)
+    , Index(index)
+    , Resolved(!index)
+  {}
+
+  FObjectRef(const FObjectRef& ref)
+    : Package(ref.Package)
+    , Index(ref.Index)
+    , Object(ref.Object.load())
+    , Resolved(ref.Resolved.load())
+  {}
+
+  FObjectRef& operator=(const FObjectRef& ref)
+  {
+    Package = ref.Package;
+    Index = ref.Index;
+    Object = ref.Object.load();
+    Resolved = ref.Resolved.load();
+    return *this;
+  }
+
+  // Resolve and load the object
+  UObject* Get() const;
+
+  PACKAGE_INDEX GetIndex() const
+  {
+    return Index;
+  }
+
+  bool IsResolved() const
+  {
+    return Resolved;
+  }
+
+  // Doesn't resolve the reference
+  bool IsNull() const
+  {
+    return Resolved ? !Object.load() : !Index;
+  }
+
+  // Reading records the index only. Writing doesn't resolve references to the same package.
+  friend FStream& operator<<(FStream& s, FObjectRef& ref);
+
+protected:
+  FPackage* Package = nullptr;
+  PACKAGE_INDEX Index = 0;
+  mutable std::atomic<UObject*> Object = { nullptr };
+  mutable std::atomic_bool Resolved = { true };
+};
+
+template <typename T>
+class TObjectRef : public FObjectRef {
+public:
+  TObjectRef()
+  {}
+
+  TObjectRef(T* object)
+    : FObjectRef((UObject*)object)
+  {}
+
+  TObjectRef(FPackage* package, PACKAGE_INDEX index)
+    : FObjectRef(package, index)
+  {}
+
+  T* Get() const
+  {
+    UObject* obj = FObjectRef::Get();
+    return obj && obj->IsA<T>() ? (T*)obj : nullptr;
+  }
+
+  operator T*() const
+  {
+    return Get();
+  }
+
+  T* operator->() const
+  {
+    return Get();
+  }
+
+  friend FStream& operator<<(FStream& s, TObjectRef<T>& ref)
+  {
+    return s << (FObjectRef&)ref;
+  }
+};
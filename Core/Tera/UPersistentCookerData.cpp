@@ -4,12 +4,12 @@
 
 #include <filesystem>
 
-void UPersistentCookerData::GetPersistentData(std::unordered_map<FString, FBulkDataInfo>& outputBulk, std::unordered_map<FString, FTextureFileCacheInfo>& outputTFC)
+void UPersistentCookerData::GetPersistentData(FStringMap<FBulkDataInfo>& outputBulk, FStringMap<FTextureFileCacheInfo>& outputTFC)
 {
   if (!IsLoaded())
   {
-    FReadStream fs(GetPackage()->GetDataPath());
-    fs.SetPackage(GetPackage());
+    std::unique_ptr<FStream> fsPtr = GetPackage()->CreateDataStream();
+    FStream& fs = *fsPtr;
 
     // Temporary sacrifice ~500Mb of RAM to get much lower load time
     void* rawData = malloc(Export->SerialSize);
@@ -88,7 +88,7 @@ void UPersistentCookerData::GetPersistentData(std::unordered_map<FString, FBulkD
         bulkDataStream << key;
         bulkDataStream << tmp;
 
-        outputBulk.emplace(key.ToUpper(), FBulkDataInfo(tmp));
+        outputBulk.emplace(key, FBulkDataInfo(tmp));
       }
       DBreakIf(!bulkDataStream.IsGood());
     });
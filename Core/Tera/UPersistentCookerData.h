@@ -7,7 +7,7 @@ public:
   DECL_UOBJ(UPersistentCookerData, UObject);
 
 	// Load only needed maps without object serialization
-	void GetPersistentData(std::unordered_map<FString, FBulkDataInfo>& outputBulk, std::unordered_map<FString, FTextureFileCacheInfo>& outputTFC);
+	void GetPersistentData(FStringMap<FBulkDataInfo>& outputBulk, FStringMap<FTextureFileCacheInfo>& outputTFC);
 
 	void Serialize(FStream& s) override;
 
@@ -336,6 +336,88 @@ void FStaticLODModel::Serialize(FStream& s, UObject* owner)
   s << VertexInfluences;
   s << Unk;
   DBreakIf(Unk.GetElementCount());
+
+  if (s.IsReading())
+  {
+    BuildInfluenceIndex();
+  }
+}
+
+void FStaticLODModel::BuildInfluenceIndex()
+{
+  // Counting sort by bone: count, prefix sum, fill
+  InfluenceIndex.Offsets.clear();
+  InfluenceIndex.Influences.clear();
+
+  uint16 maxBone = 0;
+  bool hasBones = false;
+  for (const FSkelMeshChunk& chunk : Chunks)
+  {
+    for (uint16 bone : chunk.BoneMap)
+    {
+      maxBone = std::max(maxBone, bone);
+      hasBones = true;
+    }
+  }
+  if (!hasBones)
+  {
+    return;
+  }
+
+  std::vector<uint32>& offsets = InfluenceIndex.Offsets;
+  offsets.resize((size_t)maxBone + 2, 0);
+
+  auto forEachInfluence = [&](auto func) {
+    uint32 vertexIndex = 0;
+    for (const FSkelMeshChunk& chunk : Chunks)
+    {
+      for (const FRigidSkinVertex& v : chunk.RigidVertices)
+      {
+        if (v.Bone < chunk.BoneMap.size())
+        {
+          func(chunk.BoneMap[v.Bone], vertexIndex, 1.f);
+        }
+        vertexIndex++;
+      }
+      for (const FSoftSkinVertex& v : chunk.SoftVertices)
+      {
+        for (int32 idx = 0; idx < MAX_INFLUENCES; ++idx)
+        {
+          if (v.InfluenceWeights[idx] && v.InfluenceBones[idx] < chunk.BoneMap.size())
+          {
+            func(chunk.BoneMap[v.InfluenceBones[idx]], vertexIndex, (float)v.InfluenceWeights[idx] / 255.f);
+          }
+        }
+        vertexIndex++;
+      }
+    }
+  };
+
+  forEachInfluence([&](uint16 bone, uint32, float) {
+    offsets[(size_t)bone + 1]++;
+  });
+  for (size_t idx = 1; idx < offsets.size(); ++idx)
+  {
+    offsets[idx] += offsets[idx - 1];
+  }
+
+  InfluenceIndex.Influences.resize(offsets.back());
+  std::vector<uint32> cursor(offsets.begin(), offsets.end() - 1);
+  forEachInfluence([&](uint16 bone, uint32 vertexIndex, float weight) {
+    FSkinInfluenceIndex::Influence& influence = InfluenceIndex.Influences[cursor[bone]++];
+    influence.VertexIndex = vertexIndex;
+    influence.Weight = weight;
+  });
+}
+
+uint32 FStaticLODModel::GetVertexCount() const
+{
+  uint32 result = 0;
+  for (const FSkelMeshChunk& chunk : Chunks)
+  {
+    result += (uint32)(chunk.RigidVertices.size() + chunk.SoftVertices.size());
+  }
+  return result;
 }
 
 std::vector<FSoftSkinVertex> FStaticLODModel::GetVertices() const
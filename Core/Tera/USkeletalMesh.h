@@ -438,13 +438,70 @@ struct FPerPolyBoneCollisionData {
 	friend FStream& operator<<(FStream& s, FPerPolyBoneCollisionData& d);
 };
 
+// Bone to vertex influences in CSR layout. Influences of the bone N are stored in
+// Influences[Offsets[N]...Offsets[N + 1]). Vertex indices match FStaticLODModel::GetVertices order.
+struct FSkinInfluenceIndex {
+	struct Influence {
+		uint32 VertexIndex = 0;
+		float Weight = 0.f;
+	};
+
+	std::vector<uint32> Offsets;
+	std::vector<Influence> Influences;
+
+	inline int32 GetBoneCount() const
+	{
+		return Offsets.size() ? (int32)Offsets.size() - 1 : 0;
+	}
+
+	inline const Influence* GetInfluences(int32 boneIndex, uint32& outCount) const
+	{
+		if (boneIndex < 0 || boneIndex >= GetBoneCount())
+		{
+			outCount = 0;
+			return nullptr;
+		}
+		outCount = Offsets[boneIndex + 1] - Offsets[boneIndex];
+		return Influences.data() + Offsets[boneIndex];
+	}
+};
+
 class FStaticLODModel {
 public:
 
 	void Serialize(FStream& s, UObject* owner);
 
+	// Copies all chunk vertices. Prefer ForEachVertex if you don't need to own the data
 	std::vector<FSoftSkinVertex> GetVertices() const;
 
+	// Number of vertices in all chunks
+	uint32 GetVertexCount() const;
+
+	// Iterate chunk vertices in GetVertices order without copying them.
+	// func(uint32 index, const auto& vertex) receives either FRigidSkinVertex or FSoftSkinVertex
+	template <typename TFunc>
+	void ForEachVertex(TFunc func) const
+	{
+		uint32 index = 0;
+		for (const FSkelMeshChunk& chunk : Chunks)
+		{
+			for (const FRigidSkinVertex& v : chunk.RigidVertices)
+			{
+				func(index++, v);
+			}
+			for (const FSoftSkinVertex& v : chunk.SoftVertices)
+			{
+				func(index++, v);
+			}
+		}
+	}
+
+	// Bone to vertex influences. Built once when the model is loaded
+	const FSkinInfluenceIndex& GetInfluenceIndex() const
+	{
+		return InfluenceIndex;
+	}
+
 	std::vector<const FSkelMeshSection*> GetSections() const
 	{
 		std::vector<const FSkelMeshSection*> result;
@@ -485,6 +542,10 @@ private:
 	FSkeletalMeshColorBuffer ColorBuffer;
 	std::vector<FSkeletalMeshVertexInfluences> VertexInfluences;
 	FMultiSizeIndexContainer Unk;
+
+	FSkinInfluenceIndex InfluenceIndex;
+
+	void BuildInfluenceIndex();
 };
 
 class USkeletalMesh : public UObject {
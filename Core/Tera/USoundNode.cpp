@@ -30,21 +30,29 @@ bool USoundNodeWave::RegisterProperty(FPropertyTag* property)
 void USoundNodeWave::Serialize(FStream& s)
 {
   Super::Serialize(s);
-  EditorData.Serialize(s, this);
-  PCData.Serialize(s, this);
-  XBoxData.Serialize(s, this);
-  PS3Data.Serialize(s, this);
-  UnkData1.Serialize(s, this);
-  UnkData2.Serialize(s, this);
-  UnkData3.Serialize(s, this);
-  UnkData4.Serialize(s, this);
-  UnkData5.Serialize(s, this);
+  // Payloads are read on demand. Saving materializes them
+  std::unique_lock<std::mutex> lock(ResourceMutex, std::defer_lock);
+  if (!s.IsReading())
+  {
+    lock.lock();
+  }
+  EditorData.SerializeLazy(s, this);
+  PCData.SerializeLazy(s, this);
+  XBoxData.SerializeLazy(s, this);
+  PS3Data.SerializeLazy(s, this);
+  UnkData1.SerializeLazy(s, this);
+  UnkData2.SerializeLazy(s, this);
+  UnkData3.SerializeLazy(s, this);
+  UnkData4.SerializeLazy(s, this);
+  UnkData5.SerializeLazy(s, this);
 }
 
-void USoundNodeWave::PostLoad()
+const void* USoundNodeWave::GetResourceData()
 {
-  if ((ResourceSize = PCData.GetBulkDataSize()))
+  std::scoped_lock<std::mutex> lock(ResourceMutex);
+  if (!PCData.IsMaterialized())
   {
-    PCData.GetCopy(&ResourceData);
+    PCData.Materialize();
   }
+  return PCData.GetAllocation();
 }
@@ -2,6 +2,8 @@
 #include "UObject.h"
 #include <Utils/SoundTravaller.h>
 
+#include <mutex>
+
 class USoundNodeWave : public UObject {
 public:
   DECL_UOBJ(USoundNodeWave, UObject);
@@ -13,24 +15,16 @@ public:
   bool RegisterProperty(FPropertyTag* property) override;
 
   void Serialize(FStream& s) override;
-  void PostLoad() override;
 
-  const void* GetResourceData() const
-  {
-    return ResourceData;
-  }
+  // Ogg payload. Read from the package on the first access. The pointer stays valid until the data is replaced
+  const void* GetResourceData();
 
   uint32 GetResourceSize() const
   {
-    return ResourceSize;
-  }
-
-  ~USoundNodeWave() override
-  {
-    free(ResourceData);
+    return PCData.GetBulkDataSize();
   }
 
-  friend bool SoundTravaller::Visit(USoundNodeWave* texture);
+  friend class SoundTravaller;
 
 protected:
   FByteBulkData EditorData;
@@ -43,6 +37,5 @@ protected:
   FByteBulkData UnkData4;
   FByteBulkData UnkData5;
 
-  void* ResourceData = nullptr;
-  uint32 ResourceSize = 0;
+  std::mutex ResourceMutex;
 };
@@ -70,23 +70,23 @@ bool USpeedTree::RegisterProperty(FPropertyTag* property)
   return false;
 }
 
-void USpeedTree::PostLoad()
-{
-  Super::PostLoad();
-  LoadObject(BillboardMaterial);
-  LoadObject(LeafMaterial);
-  LoadObject(LeafMeshMaterial);
-  LoadObject(LeafCardMaterial);
-  LoadObject(FrondMaterial);
-  LoadObject(BranchMaterial);
-  LoadObject(Branch1Material);
-  LoadObject(Branch2Material);
-}
-
 void USpeedTree::Serialize(FStream& s)
 {
   Super::Serialize(s);
   DBreakIf(!bLegacySpeedTree || bLegacySpeedTreeProperty);
+  if (s.IsReading() && s.GetPackage())
+  {
+    // The blob is read on demand
+    s << SpeedTreeDataSize;
+    SpeedTreeDataOffset = s.GetPosition();
+    s.SetPosition(SpeedTreeDataOffset + SpeedTreeDataSize);
+    return;
+  }
+  if (!s.IsReading())
+  {
+    std::scoped_lock<std::mutex> lock(SpeedTreeDataMutex);
+    LoadSpeedTreeData();
+  }
   s << SpeedTreeDataSize;
   if (s.IsReading() && SpeedTreeDataSize)
   {
@@ -95,20 +95,56 @@ void USpeedTree::Serialize(FStream& s)
   s.SerializeBytes(SpeedTreeData, SpeedTreeDataSize);
 }
 
-bool USpeedTree::GetSptData(void** output, FILE_OFFSET* outputSize, bool embedMaterialInfo)
+bool USpeedTree::GetSptData(const void** output, FILE_OFFSET* outputSize, bool embedMaterialInfo)
 {
   if (!output || !bLegacySpeedTree)
   {
     return false;
   }
   *output = nullptr;
-  *outputSize = SpeedTreeDataSize;
-  if (SpeedTreeDataSize)
+  *outputSize = 0;
   {
-    *output = malloc(SpeedTreeDataSize);
-    memcpy(*output, SpeedTreeData, SpeedTreeDataSize);
-    // TODO: embed materials
-    return true;
+    std::scoped_lock<std::mutex> lock(SpeedTreeDataMutex);
+    LoadSpeedTreeData();
+    if (!SpeedTreeData || !SpeedTreeDataSize)
+    {
+      return false;
+    }
+    *output = SpeedTreeData;
+    *outputSize = SpeedTreeDataSize;
   }
-  return false;
+  // TODO: embed materials when embedMaterialInfo is set
+  return true;
+}
+
+std::vector<UObject*> USpeedTree::GetMaterials()
+{
+  std::vector<UObject*> result = { BillboardMaterial, LeafMaterial, LeafMeshMaterial, LeafCardMaterial, FrondMaterial, BranchMaterial, Branch1Material, Branch2Material };
+  for (UObject* material : result)
+  {
+    LoadObject(material);
+  }
+  return result;
+}
+
+void USpeedTree::LoadSpeedTreeData()
+{
+  if (SpeedTreeDataOffset == INDEX_NONE)
+  {
+    return;
+  }
+  if (SpeedTreeDataSize <= 0)
+  {
+    SpeedTreeDataOffset = INDEX_NONE;
+    return;
+  }
+  void* data = malloc(SpeedTreeDataSize);
+  if (!GetPackage()->ReadDeferredData(SpeedTreeDataOffset, [&](FStream& s) { s.SerializeBytes(data, SpeedTreeDataSize); }))
+  {
+    free(data);
+    LogE("Failed to read SpeedTree data of %s", GetObjectName().C_str());
+    return;
+  }
+  free(SpeedTreeData);
+  SpeedTreeData = data;
 }
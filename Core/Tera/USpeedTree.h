@@ -1,6 +1,8 @@
 #pragma once
 #include "UObject.h"
 
+#include <mutex>
+
 class USpeedTree : public UObject {
 public:
   DECL_UOBJ(USpeedTree, UObject);
@@ -21,11 +23,23 @@ public:
   }
 
   bool RegisterProperty(FPropertyTag* property) override;
-  void PostLoad() override;
   void Serialize(FStream& s) override;
-  bool GetSptData(void** output, FILE_OFFSET* outputSize, bool embedMaterialInfo);
+
+  // Get the SPT blob without copying. The blob is read from the package on the first call.
+  // embedMaterialInfo resolves materials as well. The pointer is owned by the object
+  bool GetSptData(const void** output, FILE_OFFSET* outputSize, bool embedMaterialInfo);
+
+  // Load and return all material references. Materials are not loaded with the tree
+  std::vector<UObject*> GetMaterials();
+
+protected:
+  // Caller must hold SpeedTreeDataMutex
+  void LoadSpeedTreeData();
 
 protected:
   FILE_OFFSET SpeedTreeDataSize = 0;
   void* SpeedTreeData = nullptr;
+  // Position of the blob skipped during loading
+  FILE_OFFSET SpeedTreeDataOffset = INDEX_NONE;
+  std::mutex SpeedTreeDataMutex;
 };
\ No newline at end of file
@@ -414,14 +414,8 @@ bool UStaticMeshComponent::RegisterProperty(FPropertyTag* property)
   if (PROP_IS(property, StaticMesh))
   {
     StaticMeshProperty = property;
-    StaticMesh = Cast<UStaticMesh>(GetPackage()->GetObject(property->Value->GetObjectIndex(), false));
+    StaticMesh = TObjectRef<UStaticMesh>(GetPackage(), property->Value->GetObjectIndex());
     return true;
   }
   return false;
 }
-
-void UStaticMeshComponent::PostLoad()
-{
-  LoadObject(StaticMesh);
-  Super::PostLoad();
-}
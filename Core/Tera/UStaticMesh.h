@@ -316,7 +316,5 @@ public:
 
   bool RegisterProperty(FPropertyTag* property) override;
 
-  UPROP(UStaticMesh*, StaticMesh, nullptr);
-
-  void PostLoad() override;
+  UPROP(TObjectRef<UStaticMesh>, StaticMesh, nullptr);
 };
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "UTexture.h"
 #include "Cast.h"
 #include "FPackage.h"
+#include "UClass.h"
+#include "UProperty.h"
 
 #include "ALog.h"
 
@@ -325,6 +327,47 @@ void UTexture2D::DisableCaching()
   MarkDirty();
 }
 
+bool UTexture2D::SetTextureFileCacheName(const FString& name)
+{
+  if (TextureFileCacheNameProperty)
+  {
+    TextureFileCacheName->SetString(name);
+    return true;
+  }
+
+  UProperty* classProperty = GetClass() ? GetClass()->GetPropertyLink() : nullptr;
+  for (; classProperty; classProperty = classProperty->PropertyLinkNext)
+  {
+    if (classProperty->GetObjectName() == "TextureFileCacheName")
+    {
+      break;
+    }
+  }
+  if (!classProperty)
+  {
+    return false;
+  }
+
+  FPropertyTag* tag = new FPropertyTag(this);
+  tag->Name = FName(GetPackage(), "TextureFileCacheName");
+  tag->Type = FName(GetPackage(), NAME_NameProperty);
+  tag->Size = 8;
+  tag->ClassProperty = classProperty;
+  tag->Value->Type = FPropertyValue::VID::Name;
+  tag->Value->Data = new FName(GetPackage(), name);
+
+  // Keep the None tag last
+  auto it = Properties.end();
+  if (Properties.size() && Properties.back()->Name == NAME_None)
+  {
+    it--;
+  }
+  Properties.insert(it, tag);
+  TextureFileCacheNameProperty = tag;
+  TextureFileCacheName = tag->Value->GetNamePtr();
+  return true;
+}
+
 void UTexture2D::PostLoad()
 {
   Super::PostLoad();
@@ -380,7 +423,6 @@ void UTexture2D::PostLoad()
       // Maybe the texture is not cached. Search by bulkdata name
 
       FString bulkDataName = GetObjectPath() + ".MipLevel_" + std::to_string(idx);
-      bulkDataName = bulkDataName.ToUpper();
       FBulkDataInfo* info = FPackage::GetBulkDataInfo(bulkDataName);
       if (!info)
       {
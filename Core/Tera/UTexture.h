@@ -56,6 +56,10 @@ public:
   // Needed for cross-region mods
   void DisableCaching();
 
+  // Point the texture to a texture file cache. Creates TextureFileCacheName if the texture has none.
+  // Returns false if the property can't be created.
+  bool SetTextureFileCacheName(const FString& name);
+
 protected:
   void PostLoad() override;
   void DeleteStorage();
@@ -265,21 +265,20 @@ bool FbxUtils::ExportSkeletalMesh(USkeletalMesh* sourceMesh, FbxExportContext& c
     return false;
   }
 
-  const std::vector<FSoftSkinVertex> verticies = lod->GetVertices();
-  if (verticies.empty())
+  const uint32 vertexCount = lod->GetVertexCount();
+  if (!vertexCount)
   {
     ctx.Error = "The model has no vertices!";
     return false;
   }
 
   FbxMesh* mesh = FbxMesh::Create(GetScene(), "geometry");
-  mesh->InitControlPoints(verticies.size());
+  mesh->InitControlPoints(vertexCount);
 
-  for (uint32 idx = 0; idx < verticies.size(); ++idx)
-  {
-    const FSoftSkinVertex& v = verticies[idx];
-    mesh->GetControlPoints()[idx] = FbxVector4(v.Position.X, -v.Position.Y, v.Position.Z);
-  }
+  FbxVector4* controlPoints = mesh->GetControlPoints();
+  lod->ForEachVertex([&](uint32 idx, const auto& v) {
+    controlPoints[idx] = FbxVector4(v.Position.X, -v.Position.Y, v.Position.Z);
+  });
 
   FbxLayer* layer = mesh->GetLayer(0);
   if (!layer)
@@ -309,9 +308,7 @@ bool FbxUtils::ExportSkeletalMesh(USkeletalMesh* sourceMesh, FbxExportContext& c
   layerElementTangent->SetMappingMode(FbxLayerElement::EMappingMode::eByControlPoint);
   layerElementTangent->SetReferenceMode(FbxLayerElement::EReferenceMode::eDirect);
 
-  for (uint32 idx = 0; idx < verticies.size(); ++idx)
-  {
-    const FSoftSkinVertex& v = verticies[idx];
+  lod->ForEachVertex([&](uint32 idx, const auto& v) {
     FVector tmp;
     tmp = v.TangentX;
     layerElementTangent->GetDirectArray().Add(FbxVector4(tmp.X, -tmp.Y, tmp.Z));
@@ -325,7 +322,7 @@ bool FbxUtils::ExportSkeletalMesh(USkeletalMesh* sourceMesh, FbxExportContext& c
     {
       customUVLayers[uvIdx]->GetDirectArray().Add(FbxVector2(v.UVs[uvIdx + 1].X, -v.UVs[uvIdx + 1].Y + 1.f));
     }
-  }
+  });
 
   layer->SetNormals(layerElementNormal);
   layer->SetBinormals(layerElementBinormal);
@@ -400,6 +397,7 @@ bool FbxUtils::ExportSkeletalMesh(USkeletalMesh* sourceMesh, FbxExportContext& c
   FbxAMatrix meshMatrix = meshNode->EvaluateGlobalTransform();
   FbxGeometry* meshAttribute = (FbxGeometry*)mesh;
   FbxSkin* skin = FbxSkin::Create(GetScene(), "");
+  const FSkinInfluenceIndex& influenceIndex = lod->GetInfluenceIndex();
 
   for (int boneIndex = 0; boneIndex < bonesArray.Size(); boneIndex++)
   {
@@ -409,22 +407,11 @@ bool FbxUtils::ExportSkeletalMesh(USkeletalMesh* sourceMesh, FbxExportContext& c
     currentCluster->SetLink(boneNode);
     currentCluster->SetLinkMode(FbxCluster::eTotalOne);
 
-    int32 vertIndex = 0;
-    for (const FSoftSkinVertex& v : verticies)
+    uint32 influenceCount = 0;
+    const FSkinInfluenceIndex::Influence* influences = influenceIndex.GetInfluences(boneIndex, influenceCount);
+    for (uint32 idx = 0; idx < influenceCount; ++idx)
     {
-      for (int influenceIndex = 0; influenceIndex < MAX_INFLUENCES; influenceIndex++)
-      {
-
-        uint16 influenceBone = v.BoneMap->at(v.InfluenceBones[influenceIndex]);
-        float w = (float)v.InfluenceWeights[influenceIndex];
-        float influenceWeight = w / 255.0f;
-
-        if (influenceBone == boneIndex && influenceWeight > 0.f)
-        {
-          currentCluster->AddControlPointIndex(vertIndex, influenceWeight);
-        }
-      }
-      vertIndex++;
+      currentCluster->AddControlPointIndex(influences[idx].VertexIndex, influences[idx].Weight);
     }
     currentCluster->SetTransformMatrix(meshMatrix);
     FbxAMatrix linkMatrix = boneNode->EvaluateGlobalTransform();
@@ -0,0 +1,748 @@
+#include "GlbUtils.h"
+
+#include <Tera/Cast.h>
+#include <Tera/FStream.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <ppl.h>
+
+namespace
+{
+  enum GlbConstants : uint32 {
+    GLB_MAGIC = 0x46546C67, // "glTF"
+    GLB_VERSION = 2,
+    GLB_CHUNK_JSON = 0x4E4F534A, // "JSON"
+    GLB_CHUNK_BIN = 0x004E4942, // "BIN\0"
+  };
+
+  enum GltfComponentType : int32 {
+    GLTF_UNSIGNED_BYTE = 5121,
+    GLTF_UNSIGNED_SHORT = 5123,
+    GLTF_UNSIGNED_INT = 5125,
+    GLTF_FLOAT = 5126,
+  };
+
+  enum GltfBufferTarget : int32 {
+    GLTF_ARRAY_BUFFER = 34962,
+    GLTF_ELEMENT_ARRAY_BUFFER = 34963,
+  };
+
+  // Rotates the Z-up Unreal space to the Y-up glTF space
+  const double ZUpToYUp[4] = { -0.70710678118654752, 0., 0., 0.70710678118654752 };
+
+  inline uint32 Align4(uint32 value)
+  {
+    return (value + 3) & ~3u;
+  }
+
+  void AppendFloat(std::string& json, double value)
+  {
+    if (!std::isfinite(value))
+    {
+      value = 0.;
+    }
+    char buffer[32];
+    int32 len = snprintf(buffer, sizeof(buffer), "%.9g", value);
+    json.append(buffer, len);
+  }
+
+  void AppendFloats(std::string& json, const double* values, int32 count)
+  {
+    json += '[';
+    for (int32 idx = 0; idx < count; ++idx)
+    {
+      if (idx)
+      {
+        json += ',';
+      }
+      AppendFloat(json, values[idx]);
+    }
+    json += ']';
+  }
+
+  void AppendString(std::string& json, const std::string& str)
+  {
+    json += '"';
+    for (char ch : str)
+    {
+      switch (ch)
+      {
+      case '"':
+        json += "\\\"";
+        break;
+      case '\\':
+        json += "\\\\";
+        break;
+      case '\n':
+        json += "\\n";
+        break;
+      case '\r':
+        json += "\\r";
+        break;
+      case '\t':
+        json += "\\t";
+        break;
+      default:
+        if ((uint8)ch < 0x20)
+        {
+          char buffer[8];
+          snprintf(buffer, sizeof(buffer), "\\u%04x", (uint32)(uint8)ch);
+          json += buffer;
+        }
+        else
+        {
+          json += ch;
+        }
+      }
+    }
+    json += '"';
+  }
+
+  // Collects bufferViews and accessors while the BIN chunk layout is being planned
+  struct GltfLayout {
+    std::string BufferViews;
+    std::string Accessors;
+    int32 ViewCount = 0;
+    int32 AccessorCount = 0;
+    uint32 BinSize = 0;
+
+    int32 AddView(uint32 size, uint32 stride, int32 target)
+    {
+      if (ViewCount++)
+      {
+        BufferViews += ',';
+      }
+      BufferViews += "{\"buffer\":0,\"byteOffset\":" + std::to_string(BinSize) + ",\"byteLength\":" + std::to_string(size);
+      if (stride)
+      {
+        BufferViews += ",\"byteStride\":" + std::to_string(stride);
+      }
+      if (target)
+      {
+        BufferViews += ",\"target\":" + std::to_string(target);
+      }
+      BufferViews += '}';
+      BinSize += Align4(size);
+      return ViewCount - 1;
+    }
+
+    int32 AddAccessor(int32 view, uint32 offset, int32 componentType, uint32 count, const char* type, bool normalized = false, const double* min = nullptr, const double* max = nullptr)
+    {
+      if (AccessorCount++)
+      {
+        Accessors += ',';
+      }
+      Accessors += "{\"bufferView\":" + std::to_string(view);
+      if (offset)
+      {
+        Accessors += ",\"byteOffset\":" + std::to_string(offset);
+      }
+      Accessors += ",\"componentType\":" + std::to_string(componentType) + ",\"count\":" + std::to_string(count) + ",\"type\":\"" + type + "\"";
+      if (normalized)
+      {
+        Accessors += ",\"normalized\":true";
+      }
+      if (min && max)
+      {
+        Accessors += ",\"min\":";
+        AppendFloats(Accessors, min, 3);
+        Accessors += ",\"max\":";
+        AppendFloats(Accessors, max, 3);
+      }
+      Accessors += '}';
+      return AccessorCount - 1;
+    }
+  };
+
+  // Stages small writes and flushes them to the file in large blocks
+  class GlbBinWriter {
+  public:
+    GlbBinWriter(FStream& s)
+      : Stream(s)
+    {
+      Buffer.reserve(BufferSize);
+    }
+
+    ~GlbBinWriter()
+    {
+      Flush();
+    }
+
+    void Write(const void* data, size_t size)
+    {
+      if (Buffer.size() + size > BufferSize)
+      {
+        Flush();
+      }
+      const uint8* ptr = (const uint8*)data;
+      Buffer.insert(Buffer.end(), ptr, ptr + size);
+    }
+
+    template <typename T>
+    void Write(const T& value)
+    {
+      Write(&value, sizeof(T));
+    }
+
+    void Pad(uint32 size, uint8 value)
+    {
+      for (uint32 pad = Align4(size); size < pad; ++size)
+      {
+        Write(value);
+      }
+    }
+
+    void Flush()
+    {
+      if (Buffer.size())
+      {
+        Stream.SerializeBytes(Buffer.data(), (FILE_OFFSET)Buffer.size());
+        Buffer.clear();
+      }
+    }
+
+  private:
+    static constexpr size_t BufferSize = 1024 * 64;
+    FStream& Stream;
+    std::vector<uint8> Buffer;
+  };
+
+  struct GlbPrimitive {
+    uint32 FirstIndex = 0;
+    uint32 NumIndices = 0;
+    int32 Material = INDEX_NONE;
+  };
+
+  struct GlbMesh {
+    std::string Name;
+    uint32 NumVertices = 0;
+    uint32 NumTexCoords = 1;
+    bool Skinned = false;
+    std::vector<GlbPrimitive> Primitives;
+    std::vector<std::string> Materials;
+    double Min[3] = { 0., 0., 0. };
+    double Max[3] = { 0., 0., 0. };
+  };
+
+  struct GlbJoint {
+    std::string Name;
+    int32 Parent = INDEX_NONE;
+    double Translation[3] = { 0., 0., 0. };
+    double Rotation[4] = { 0., 0., 0., 1. };
+  };
+
+  // Rigid transform helpers for the inverse bind matrices
+  void QuatMul(const double* a, const double* b, double* out)
+  {
+    double r[4];
+    r[0] = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+    r[1] = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+    r[2] = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+    r[3] = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+    memcpy(out, r, sizeof(r));
+  }
+
+  void QuatRotate(const double* q, const double* v, double* out)
+  {
+    const double p[4] = { v[0], v[1], v[2], 0. };
+    const double c[4] = { -q[0], -q[1], -q[2], q[3] };
+    double tmp[4];
+    QuatMul(q, p, tmp);
+    QuatMul(tmp, c, tmp);
+    out[0] = tmp[0];
+    out[1] = tmp[1];
+    out[2] = tmp[2];
+  }
+
+  void WriteInverseBindMatrix(GlbBinWriter& bin, const double* rotation, const double* translation)
+  {
+    const double q[4] = { -rotation[0], -rotation[1], -rotation[2], rotation[3] };
+    double t[3];
+    QuatRotate(q, translation, t);
+    const double x = q[0], y = q[1], z = q[2], w = q[3];
+    // Column-major
+    const float m[16] = {
+      (float)(1. - 2. * (y * y + z * z)), (float)(2. * (x * y + z * w)), (float)(2. * (x * z - y * w)), 0.f,
+      (float)(2. * (x * y - z * w)), (float)(1. - 2. * (x * x + z * z)), (float)(2. * (y * z + x * w)), 0.f,
+      (float)(2. * (x * z + y * w)), (float)(2. * (y * z - x * w)), (float)(1. - 2. * (x * x + y * y)), 0.f,
+      (float)-t[0], (float)-t[1], (float)-t[2], 1.f
+    };
+    bin.Write(m, sizeof(m));
+  }
+
+  void NormalizeQuat(double* q)
+  {
+    const double len = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    if (len < 1e-8)
+    {
+      q[0] = q[1] = q[2] = 0.;
+      q[3] = 1.;
+      return;
+    }
+    for (int32 idx = 0; idx < 4; ++idx)
+    {
+      q[idx] /= len;
+    }
+  }
+
+  inline void WriteNormal(GlbBinWriter& bin, const FVector& n)
+  {
+    float x = n.X, y = -n.Y, z = n.Z;
+    const float len = std::sqrt(x * x + y * y + z * z);
+    if (len > 1e-6f)
+    {
+      x /= len; y /= len; z /= len;
+    }
+    else
+    {
+      x = 0.f; y = 0.f; z = 1.f;
+    }
+    bin.Write(x);
+    bin.Write(y);
+    bin.Write(z);
+  }
+
+  inline void UpdateBounds(GlbMesh& mesh, const FVector& p, bool first)
+  {
+    const double v[3] = { p.X, -p.Y, p.Z };
+    for (int32 idx = 0; idx < 3; ++idx)
+    {
+      if (first || v[idx] < mesh.Min[idx])
+      {
+        mesh.Min[idx] = v[idx];
+      }
+      if (first || v[idx] > mesh.Max[idx])
+      {
+        mesh.Max[idx] = v[idx];
+      }
+    }
+  }
+
+  // Writes the whole GLB file. Vertices are interleaved into a single bufferView, so
+  // writeVertices streams the LOD exactly once. writeIndices(primitive, bin) emits uint32 indices.
+  template <typename TVertexWriter, typename TIndexWriter>
+  bool WriteGlb(GlbExportContext& ctx, const GlbMesh& mesh, const std::vector<GlbJoint>& joints, TVertexWriter writeVertices, TIndexWriter writeIndices)
+  {
+    const bool skinned = mesh.Skinned && joints.size();
+    const uint32 vertexStride = 24 + 8 * mesh.NumTexCoords + (skinned ? 12 : 0);
+    uint32 numIndices = 0;
+    for (const GlbPrimitive& primitive : mesh.Primitives)
+    {
+      numIndices += primitive.NumIndices;
+    }
+
+    GltfLayout layout;
+    const int32 vertexView = layout.AddView(vertexStride * mesh.NumVertices, vertexStride, GLTF_ARRAY_BUFFER);
+    const int32 indexView = layout.AddView(numIndices * sizeof(uint32), 0, GLTF_ELEMENT_ARRAY_BUFFER);
+    const int32 ibmView = skinned ? layout.AddView((uint32)joints.size() * 64, 0, 0) : INDEX_NONE;
+
+    std::string attributes = "{\"POSITION\":" + std::to_string(layout.AddAccessor(vertexView, 0, GLTF_FLOAT, mesh.NumVertices, "VEC3", false, mesh.Min, mesh.Max));
+    attributes += ",\"NORMAL\":" + std::to_string(layout.AddAccessor(vertexView, 12, GLTF_FLOAT, mesh.NumVertices, "VEC3"));
+    for (uint32 uvIdx = 0; uvIdx < mesh.NumTexCoords; ++uvIdx)
+    {
+      attributes += ",\"TEXCOORD_" + std::to_string(uvIdx) + "\":" + std::to_string(layout.AddAccessor(vertexView, 24 + uvIdx * 8, GLTF_FLOAT, mesh.NumVertices, "VEC2"));
+    }
+    if (skinned)
+    {
+      const uint32 offset = 24 + 8 * mesh.NumTexCoords;
+      attributes += ",\"JOINTS_0\":" + std::to_string(layout.AddAccessor(vertexView, offset, GLTF_UNSIGNED_SHORT, mesh.NumVertices, "VEC4"));
+      attributes += ",\"WEIGHTS_0\":" + std::to_string(layout.AddAccessor(vertexView, offset + 8, GLTF_UNSIGNED_BYTE, mesh.NumVertices, "VEC4", true));
+    }
+    attributes += '}';
+
+    std::string primitives;
+    uint32 indexOffset = 0;
+    for (const GlbPrimitive& primitive : mesh.Primitives)
+    {
+      if (primitives.size())
+      {
+        primitives += ',';
+      }
+      primitives += "{\"attributes\":" + attributes + ",\"indices\":" + std::to_string(layout.AddAccessor(indexView, indexOffset, GLTF_UNSIGNED_INT, primitive.NumIndices, "SCALAR"));
+      if (primitive.Material != INDEX_NONE)
+      {
+        primitives += ",\"material\":" + std::to_string(primitive.Material);
+      }
+      primitives += '}';
+      indexOffset += primitive.NumIndices * sizeof(uint32);
+    }
+
+    // Nodes: 0 - Y-up root, 1 - mesh, 2.. - joints
+    std::string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"Real Editor\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"name\":";
+    AppendString(json, mesh.Name);
+    json += ",\"rotation\":";
+    AppendFloats(json, ZUpToYUp, 4);
+    json += ",\"children\":[1";
+    if (skinned)
+    {
+      json += ",2";
+    }
+    json += "]},{\"name\":";
+    AppendString(json, mesh.Name);
+    json += ",\"mesh\":0";
+    if (skinned)
+    {
+      json += ",\"skin\":0";
+    }
+    json += '}';
+    if (skinned)
+    {
+      std::vector<std::vector<int32>> children(joints.size());
+      for (int32 idx = 1; idx < (int32)joints.size(); ++idx)
+      {
+        int32 parent = joints[idx].Parent;
+        if (parent >= 0 && parent < idx)
+        {
+          children[parent].push_back(idx);
+        }
+      }
+      for (int32 idx = 0; idx < (int32)joints.size(); ++idx)
+      {
+        const GlbJoint& joint = joints[idx];
+        json += ",{\"name\":";
+        AppendString(json, joint.Name);
+        json += ",\"translation\":";
+        AppendFloats(json, joint.Translation, 3);
+        json += ",\"rotation\":";
+        AppendFloats(json, joint.Rotation, 4);
+        if (children[idx].size())
+        {
+          json += ",\"children\":[";
+          for (size_t childIdx = 0; childIdx < children[idx].size(); ++childIdx)
+          {
+            json += (childIdx ? "," : "") + std::to_string(children[idx][childIdx] + 2);
+          }
+          json += ']';
+        }
+        json += '}';
+      }
+    }
+    json += "],\"meshes\":[{\"name\":";
+    AppendString(json, mesh.Name);
+    json += ",\"primitives\":[" + primitives + "]}]";
+    if (mesh.Materials.size())
+    {
+      json += ",\"materials\":[";
+      for (size_t idx = 0; idx < mesh.Materials.size(); ++idx)
+      {
+        json += idx ? ",{\"name\":" : "{\"name\":";
+        AppendString(json, mesh.Materials[idx]);
+        json += '}';
+      }
+      json += ']';
+    }
+    if (skinned)
+    {
+      json += ",\"skins\":[{\"inverseBindMatrices\":" + std::to_string(layout.AddAccessor(ibmView, 0, GLTF_FLOAT, (uint32)joints.size(), "MAT4"));
+      json += ",\"skeleton\":2,\"joints\":[";
+      for (size_t idx = 0; idx < joints.size(); ++idx)
+      {
+        json += (idx ? "," : "") + std::to_string(idx + 2);
+      }
+      json += "]}]";
+    }
+    json += ",\"bufferViews\":[" + layout.BufferViews + "],\"accessors\":[" + layout.Accessors + "]";
+    json += ",\"buffers\":[{\"byteLength\":" + std::to_string(layout.BinSize) + "}]}";
+
+    const uint32 jsonSize = Align4((uint32)json.size());
+    const uint64 totalSize = 12ull + 8 + jsonSize + 8 + layout.BinSize;
+    if (totalSize > UINT32_MAX)
+    {
+      ctx.Error = "The model is too big for a GLB file!";
+      return false;
+    }
+
+    FWriteStream s(ctx.Path);
+    if (!s.IsGood())
+    {
+      ctx.Error = "Failed to create the file!";
+      return false;
+    }
+
+    {
+      GlbBinWriter bin(s);
+      bin.Write((uint32)GLB_MAGIC);
+      bin.Write((uint32)GLB_VERSION);
+      bin.Write((uint32)totalSize);
+
+      bin.Write(jsonSize);
+      bin.Write((uint32)GLB_CHUNK_JSON);
+      bin.Write(json.data(), json.size());
+      bin.Pad((uint32)json.size(), ' ');
+
+      bin.Write(layout.BinSize);
+      bin.Write((uint32)GLB_CHUNK_BIN);
+      writeVertices(bin);
+      bin.Pad(vertexStride * mesh.NumVertices, 0);
+      for (const GlbPrimitive& primitive : mesh.Primitives)
+      {
+        writeIndices(primitive, bin);
+      }
+      if (skinned)
+      {
+        // Global bind pose of each joint. Parents always precede their children
+        std::vector<std::array<double, 7>> global(joints.size());
+        for (size_t idx = 0; idx < joints.size(); ++idx)
+        {
+          const GlbJoint& joint = joints[idx];
+          double* rotation = global[idx].data();
+          double* translation = rotation + 4;
+          if (idx && joint.Parent != INDEX_NONE)
+          {
+            const double* parentRotation = global[joint.Parent].data();
+            const double* parentTranslation = parentRotation + 4;
+            QuatMul(parentRotation, joint.Rotation, rotation);
+            QuatRotate(parentRotation, joint.Translation, translation);
+            for (int32 axis = 0; axis < 3; ++axis)
+            {
+              translation[axis] += parentTranslation[axis];
+            }
+          }
+          else
+          {
+            memcpy(rotation, joint.Rotation, sizeof(joint.Rotation));
+            memcpy(translation, joint.Translation, sizeof(joint.Translation));
+          }
+          WriteInverseBindMatrix(bin, rotation, translation);
+        }
+      }
+    }
+
+    if (!s.IsGood())
+    {
+      ctx.Error = "Failed to write data!";
+      return false;
+    }
+    return true;
+  }
+}
+
+bool GlbUtils::ExportStaticMesh(UStaticMesh* sourceMesh, GlbExportContext& ctx)
+{
+  const FStaticMeshRenderData* lod = sourceMesh->GetLod(ctx.LodIndex);
+  if (!lod)
+  {
+    ctx.Error = "Failed to get the lod model!";
+    return false;
+  }
+
+  if (!lod->NumVertices)
+  {
+    ctx.Error = "The model has no vertices!";
+    return false;
+  }
+
+  GlbMesh mesh;
+  mesh.Name = sourceMesh->GetObjectName().UTF8();
+  mesh.NumVertices = lod->NumVertices;
+  mesh.NumTexCoords = std::max<uint32>(lod->VertexBuffer.NumTexCoords, 1);
+
+  std::vector<UObject*> materials;
+  for (const FStaticMeshElement& element : lod->Elements)
+  {
+    if (!element.NumTriangles)
+    {
+      continue;
+    }
+    GlbPrimitive& primitive = mesh.Primitives.emplace_back();
+    primitive.FirstIndex = element.FirstIndex;
+    primitive.NumIndices = element.NumTriangles * 3;
+
+    auto it = std::find(materials.begin(), materials.end(), element.Material);
+    primitive.Material = (int32)(it - materials.begin());
+    if (it == materials.end())
+    {
+      materials.push_back(element.Material);
+    }
+  }
+
+  for (size_t idx = 0; idx < materials.size(); ++idx)
+  {
+    UObject* mat = materials[idx];
+    mesh.Materials.push_back(mat ? mat->GetObjectName().UTF8() : ("Material_" + std::to_string(idx + 1)));
+  }
+
+  for (uint32 idx = 0; idx < mesh.NumVertices; ++idx)
+  {
+    UpdateBounds(mesh, lod->PositionBuffer.Data[idx], !idx);
+  }
+
+  return WriteGlb(ctx, mesh, {}, [&](GlbBinWriter& bin) {
+    for (uint32 idx = 0; idx < mesh.NumVertices; ++idx)
+    {
+      const FStaticMeshVertexBase* v = lod->VertexBuffer.GetVertex(idx);
+      const FVector& position = lod->PositionBuffer.Data[idx];
+      bin.Write(position.X);
+      bin.Write(-position.Y);
+      bin.Write(position.Z);
+      WriteNormal(bin, v->GetTangentZ());
+      for (uint32 uvIdx = 0; uvIdx < mesh.NumTexCoords; ++uvIdx)
+      {
+        const FVector2D uv = v->GetUVs(uvIdx);
+        bin.Write(uv.X);
+        bin.Write(uv.Y);
+      }
+    }
+  }, [&](const GlbPrimitive& primitive, GlbBinWriter& bin) {
+    for (uint32 idx = 0; idx < primitive.NumIndices; ++idx)
+    {
+      bin.Write(lod->IndexBuffer.GetIndex(primitive.FirstIndex + idx));
+    }
+  });
+}
+
+bool GlbUtils::ExportSkeletalMesh(USkeletalMesh* sourceMesh, GlbExportContext& ctx)
+{
+  const FStaticLODModel* lod = sourceMesh->GetLod(ctx.LodIndex);
+  if (!lod)
+  {
+    ctx.Error = "Failed to get the lod model!";
+    return false;
+  }
+
+  GlbMesh mesh;
+  mesh.Name = sourceMesh->GetObjectName().UTF8();
+  mesh.NumVertices = lod->GetVertexCount();
+  mesh.NumTexCoords = std::clamp<uint32>(lod->GetNumTexCoords(), 1, MAX_TEXCOORDS);
+  if (!mesh.NumVertices)
+  {
+    ctx.Error = "The model has no vertices!";
+    return false;
+  }
+
+  const std::vector<UObject*> materials = sourceMesh->GetMaterials();
+  for (size_t idx = 0; idx < materials.size(); ++idx)
+  {
+    UObject* mat = materials[idx];
+    mesh.Materials.push_back(mat ? mat->GetObjectName().UTF8() : ("Material_" + std::to_string(idx + 1)));
+  }
+
+  for (const FSkelMeshSection* section : lod->GetSections())
+  {
+    if (!section->NumTriangles)
+    {
+      continue;
+    }
+    GlbPrimitive& primitive = mesh.Primitives.emplace_back();
+    primitive.FirstIndex = section->BaseIndex;
+    primitive.NumIndices = section->NumTriangles * 3;
+    primitive.Material = section->MaterialIndex < materials.size() ? section->MaterialIndex : INDEX_NONE;
+  }
+
+  std::vector<GlbJoint> joints;
+  if (ctx.ExportSkeleton)
+  {
+    const std::vector<FMeshBone> refSkeleton = sourceMesh->GetReferenceSkeleton();
+    joints.resize(refSkeleton.size());
+    for (size_t idx = 0; idx < refSkeleton.size(); ++idx)
+    {
+      const FMeshBone& bone = refSkeleton[idx];
+      GlbJoint& joint = joints[idx];
+      joint.Name = bone.Name.String().UTF8();
+      joint.Parent = idx ? bone.ParentIndex : INDEX_NONE;
+      if (idx && (joint.Parent < 0 || joint.Parent >= (int32)idx))
+      {
+        ctx.Error = "Failed to build the skeleton!";
+        return false;
+      }
+      // Same handedness conversion as the FBX exporter
+      joint.Translation[0] = bone.BonePos.Position.X;
+      joint.Translation[1] = -bone.BonePos.Position.Y;
+      joint.Translation[2] = bone.BonePos.Position.Z;
+      joint.Rotation[0] = bone.BonePos.Orientation.X;
+      joint.Rotation[1] = -bone.BonePos.Orientation.Y;
+      joint.Rotation[2] = bone.BonePos.Orientation.Z;
+      joint.Rotation[3] = -bone.BonePos.Orientation.W;
+      NormalizeQuat(joint.Rotation);
+    }
+    mesh.Skinned = !joints.empty();
+  }
+
+  lod->ForEachVertex([&](uint32 idx, const auto& v) {
+    UpdateBounds(mesh, v.Position, !idx);
+  });
+
+  return WriteGlb(ctx, mesh, joints, [&](GlbBinWriter& bin) {
+    const uint16 boneCount = (uint16)joints.size();
+    auto mapBone = [boneCount](const std::vector<uint16>* boneMap, uint8 bone) -> uint16 {
+      uint16 result = boneMap && bone < boneMap->size() ? (*boneMap)[bone] : bone;
+      return result < boneCount ? result : 0;
+    };
+    lod->ForEachVertex([&](uint32 idx, const auto& v) {
+      bin.Write(v.Position.X);
+      bin.Write(-v.Position.Y);
+      bin.Write(v.Position.Z);
+      FVector normal;
+      normal = v.TangentZ;
+      WriteNormal(bin, normal);
+      for (uint32 uvIdx = 0; uvIdx < mesh.NumTexCoords; ++uvIdx)
+      {
+        bin.Write(v.UVs[uvIdx].X);
+        bin.Write(v.UVs[uvIdx].Y);
+      }
+      if (!mesh.Skinned)
+      {
+        return;
+      }
+      uint16 bones[MAX_INFLUENCES] = {};
+      uint8 weights[MAX_INFLUENCES] = {};
+      if constexpr (std::is_same_v<std::decay_t<decltype(v)>, FRigidSkinVertex>)
+      {
+        bones[0] = mapBone(v.BoneMap, v.Bone);
+        weights[0] = 0xFF;
+      }
+      else
+      {
+        for (int32 influence = 0; influence < MAX_INFLUENCES; ++influence)
+        {
+          if (v.InfluenceWeights[influence])
+          {
+            bones[influence] = mapBone(v.BoneMap, v.InfluenceBones[influence]);
+            weights[influence] = v.InfluenceWeights[influence];
+          }
+        }
+      }
+      bin.Write(bones, sizeof(bones));
+      bin.Write(weights, sizeof(weights));
+    });
+  }, [&](const GlbPrimitive& primitive, GlbBinWriter& bin) {
+    const FMultiSizeIndexContainer* indexContainer = lod->GetIndexContainer();
+    for (uint32 idx = 0; idx < primitive.NumIndices; ++idx)
+    {
+      bin.Write(indexContainer->GetIndex(primitive.FirstIndex + idx));
+    }
+  });
+}
+
+bool GlbUtils::ExportMeshes(const std::vector<UObject*>& meshes, std::vector<GlbExportContext>& contexts)
+{
+  if (contexts.size() < meshes.size())
+  {
+    return false;
+  }
+  std::atomic_bool result(true);
+  concurrency::parallel_for(size_t(0), meshes.size(), [&](size_t idx) {
+    GlbExportContext& ctx = contexts[idx];
+    bool ok = false;
+    if (UStaticMesh* staticMesh = Cast<UStaticMesh>(meshes[idx]))
+    {
+      ok = ExportStaticMesh(staticMesh, ctx);
+    }
+    else if (USkeletalMesh* skeletalMesh = Cast<USkeletalMesh>(meshes[idx]))
+    {
+      ok = ExportSkeletalMesh(skeletalMesh, ctx);
+    }
+    else
+    {
+      ctx.Error = "The object is not a mesh!";
+    }
+    if (!ok)
+    {
+      result = false;
+    }
+  });
+  return result;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <Tera/USkeletalMesh.h>
+#include <Tera/UStaticMesh.h>
+
+struct GlbExportContext {
+  std::wstring Path;
+  bool ExportSkeleton = true;
+  uint32 LodIndex = 0;
+
+  std::string Error;
+};
+
+// Native binary glTF writer. Vertex data goes straight from the LOD buffers to the file.
+// No scene graph is built, so meshes can be exported concurrently.
+class GlbUtils {
+public:
+  static bool ExportStaticMesh(UStaticMesh* sourceMesh, GlbExportContext& ctx);
+  static bool ExportSkeletalMesh(USkeletalMesh* sourceMesh, GlbExportContext& ctx);
+
+  // Export UStaticMesh and USkeletalMesh objects in parallel. contexts[idx] is used for meshes[idx].
+  // Objects must be loaded. Returns false if any of the exports failed. Check contexts for errors.
+  static bool ExportMeshes(const std::vector<UObject*>& meshes, std::vector<GlbExportContext>& contexts);
+};
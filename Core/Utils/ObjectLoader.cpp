@@ -0,0 +1,142 @@
+#include "ObjectLoader.h"
+#include <Tera/ALog.h>
+#include <Tera/FPackage.h>
+#include <Tera/UObject.h>
+
+bool ObjectLoadRequest::Cancel()
+{
+  RequestState expected = RequestState::Queued;
+  if (!State.compare_exchange_strong(expected, RequestState::Cancelled))
+  {
+    return expected == RequestState::Cancelled;
+  }
+  Promise.set_value(false);
+  return true;
+}
+
+ObjectLoader& ObjectLoader::Get()
+{
+  static ObjectLoader loader;
+  return loader;
+}
+
+ObjectLoader::ObjectLoader(int32 threads)
+{
+  if (threads <= 0)
+  {
+    threads = std::max<int32>(std::thread::hardware_concurrency() / 2, 2);
+  }
+  for (int32 idx = 0; idx < threads; ++idx)
+  {
+    Workers.emplace_back(&ObjectLoader::WorkerMain, this);
+  }
+}
+
+ObjectLoader::~ObjectLoader()
+{
+  CancelAll();
+  {
+    std::scoped_lock<std::mutex> lock(QueueMutex);
+    Stop = true;
+  }
+  QueueCondition.notify_all();
+  for (std::thread& worker : Workers)
+  {
+    worker.join();
+  }
+}
+
+std::shared_ptr<ObjectLoadRequest> ObjectLoader::Load(const std::shared_ptr<FPackage>& package, UObject* object, LoadPriority priority, std::function<void(UObject*, bool)> onLoaded)
+{
+  std::shared_ptr<ObjectLoadRequest> request = std::make_shared<ObjectLoadRequest>();
+  request->Object = object;
+  request->Package = package;
+  request->Priority = priority;
+  request->OnLoaded = std::move(onLoaded);
+  {
+    std::scoped_lock<std::mutex> lock(QueueMutex);
+    request->Sequence = NextSequence++;
+    Queue.push(request);
+  }
+  QueueCondition.notify_one();
+  return request;
+}
+
+void ObjectLoader::CancelAll()
+{
+  std::scoped_lock<std::mutex> lock(QueueMutex);
+  while (Queue.size())
+  {
+    Queue.top()->Cancel();
+    Queue.pop();
+  }
+}
+
+void ObjectLoader::WorkerMain()
+{
+  while (true)
+  {
+    std::shared_ptr<ObjectLoadRequest> request;
+    {
+      std::unique_lock<std::mutex> lock(QueueMutex);
+      QueueCondition.wait(lock, [this] { return Stop || Queue.size(); });
+      if (Stop)
+      {
+        return;
+      }
+      request = Queue.top();
+      Queue.pop();
+    }
+    Process(request);
+  }
+}
+
+void ObjectLoader::Process(const std::shared_ptr<ObjectLoadRequest>& request)
+{
+  ObjectLoadRequest::RequestState expected = ObjectLoadRequest::RequestState::Queued;
+  if (!request->State.compare_exchange_strong(expected, ObjectLoadRequest::RequestState::Running))
+  {
+    // Cancelled while waiting in the queue
+    return;
+  }
+
+  std::shared_ptr<FPackage> package = request->Package.lock();
+  if (!package || package->IsOperationCancelled() || !request->Object)
+  {
+    request->State = ObjectLoadRequest::RequestState::Cancelled;
+    if (request->OnLoaded)
+    {
+      request->OnLoaded(request->Object, false);
+    }
+    request->Promise.set_value(false);
+    return;
+  }
+
+  bool result = true;
+  try
+  {
+    request->Object->Load();
+    // Load() doesn't throw again for an object that has already failed
+    if (request->Object->GetLoadState() == ObjectLoadState::Failed)
+    {
+      LogE("Failed to load %s", request->Object->GetObjectPath().UTF8().c_str());
+      result = false;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    LogE("Failed to load %s: %s", request->Object->GetObjectPath().UTF8().c_str(), e.what());
+    result = false;
+  }
+  catch (...)
+  {
+    LogE("Failed to load %s: Unexpected exception!", request->Object->GetObjectPath().UTF8().c_str());
+    result = false;
+  }
+
+  if (request->OnLoaded)
+  {
+    request->OnLoaded(request->Object, result);
+  }
+  request->Promise.set_value(result);
+}
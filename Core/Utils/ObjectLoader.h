@@ -0,0 +1,109 @@
+#pragma once
+#include <Tera/Core.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+class FPackage;
+class UObject;
+
+enum class LoadPriority : uint8 {
+  // Neighbours of the selection. Loaded when nothing else is waiting
+  Prefetch = 0,
+  Normal,
+  // The object the user is looking at
+  Immediate
+};
+
+// A queued load. Keep it to cancel the load or to wait for the result.
+class ObjectLoadRequest {
+public:
+  // Cancel the load. Returns true if the load has not started yet: the callback will not be called.
+  // A running load can't be interrupted. It will finish and call the callback.
+  bool Cancel();
+
+  bool IsCancelled() const
+  {
+    return State == RequestState::Cancelled;
+  }
+
+  UObject* GetObject() const
+  {
+    return Object;
+  }
+
+  // Blocks until the request is done. Returns false if the load failed or was cancelled.
+  bool Wait() const
+  {
+    return Result.get();
+  }
+
+protected:
+  friend class ObjectLoader;
+
+  enum class RequestState : uint8 {
+    Queued,
+    Running,
+    Cancelled
+  };
+
+  UObject* Object = nullptr;
+  std::weak_ptr<FPackage> Package;
+  LoadPriority Priority = LoadPriority::Normal;
+  uint64 Sequence = 0;
+  std::function<void(UObject*, bool)> OnLoaded;
+
+  std::atomic<RequestState> State = { RequestState::Queued };
+  std::promise<bool> Promise;
+  std::shared_future<bool> Result = Promise.get_future().share();
+};
+
+// Loads objects on a bounded pool of worker threads.
+// Requests with higher priority go first. Within a priority the newest request goes first,
+// so the object under the cursor is loaded before the ones the user has skipped.
+class ObjectLoader {
+public:
+  // Shared loader for editors
+  static ObjectLoader& Get();
+
+  // Zero threads means half of the hardware threads, but at least two
+  ObjectLoader(int32 threads = 0);
+  ~ObjectLoader();
+
+  // Queue the object. onLoaded is called on a worker thread with the object and the result.
+  // It's called with false if the load fails or the package is gone. Cancelled requests don't call it.
+  // The package is locked while the object loads. Requests of unloaded or cancelled packages are dropped.
+  std::shared_ptr<ObjectLoadRequest> Load(const std::shared_ptr<FPackage>& package, UObject* object, LoadPriority priority = LoadPriority::Normal, std::function<void(UObject*, bool)> onLoaded = nullptr);
+
+  // Cancel all queued requests
+  void CancelAll();
+
+private:
+  struct RequestOrder {
+    bool operator()(const std::shared_ptr<ObjectLoadRequest>& a, const std::shared_ptr<ObjectLoadRequest>& b) const
+    {
+      if (a->Priority != b->Priority)
+      {
+        return a->Priority < b->Priority;
+      }
+      return a->Sequence < b->Sequence;
+    }
+  };
+
+  void WorkerMain();
+  void Process(const std::shared_ptr<ObjectLoadRequest>& request);
+
+private:
+  std::mutex QueueMutex;
+  std::condition_variable QueueCondition;
+  std::priority_queue<std::shared_ptr<ObjectLoadRequest>, std::vector<std::shared_ptr<ObjectLoadRequest>>, RequestOrder> Queue;
+  uint64 NextSequence = 0;
+  bool Stop = false;
+  std::vector<std::thread> Workers;
+};
@@ -0,0 +1,144 @@
+#include "SceneAssembler.h"
+
+#include <Tera/ULevel.h>
+#include <Tera/UActor.h>
+#include <Tera/UStaticMesh.h>
+#include <Tera/UMaterial.h>
+#include <Tera/UTexture.h>
+#include <Tera/Cast.h>
+
+int32 SceneAssembler::AddLevel(ULevel* level, const FString& name)
+{
+  SceneLevel& entry = Levels.emplace_back();
+  entry.Level = level;
+  entry.Name = name;
+  if (!level)
+  {
+    return (int32)Levels.size() - 1;
+  }
+
+  std::vector<UActor*> actors = level->GetActors();
+  // Actors, their components and meshes
+  UObject::Prefetch(std::vector<UObject*>(actors.begin(), actors.end()), 2);
+  for (UActor* actor : actors)
+  {
+    if (UStaticMeshActor* a = Cast<UStaticMeshActor>(actor))
+    {
+      AddStaticMeshActor(a, entry);
+    }
+  }
+  return (int32)Levels.size() - 1;
+}
+
+bool SceneAssembler::AddStaticMeshActor(UStaticMeshActor* actor, SceneLevel& level)
+{
+  UStaticMeshComponent* component = actor->StaticMeshComponent;
+  if (!component)
+  {
+    return false;
+  }
+
+  UStaticMesh* mesh = component->StaticMesh;
+  // Only the model is replaced. The placement still comes from this actor and its component
+  if (UStaticMeshComponent* replacement = Cast<UStaticMeshComponent>(component->ReplacementPrimitive))
+  {
+    if (replacement->StaticMesh)
+    {
+      mesh = replacement->StaticMesh;
+    }
+  }
+
+  int32 meshIndex = GetMeshIndex(mesh, 0);
+  if (meshIndex == INDEX_NONE)
+  {
+    return false;
+  }
+
+  const float scale = actor->DrawScale * component->Scale;
+  SceneInstance& instance = Instances.emplace_back();
+  instance.Actor = actor;
+  instance.MeshIndex = meshIndex;
+  instance.Location = actor->Location + component->Translation;
+  instance.Rotation = actor->Rotation + component->Rotation;
+  instance.Scale3D = FVector(actor->DrawScale3D.X * component->Scale3D.X * scale,
+                             actor->DrawScale3D.Y * component->Scale3D.Y * scale,
+                             actor->DrawScale3D.Z * component->Scale3D.Z * scale);
+  level.Instances.push_back((int32)Instances.size() - 1);
+  return true;
+}
+
+int32 SceneAssembler::GetMeshIndex(UStaticMesh* mesh, int32 lodIndex)
+{
+  if (!mesh)
+  {
+    return INDEX_NONE;
+  }
+
+  const auto key = std::make_pair(mesh, lodIndex);
+  auto it = MeshMap.find(key);
+  if (it != MeshMap.end())
+  {
+    return it->second;
+  }
+
+  const FStaticMeshRenderData* model = mesh->GetLod(lodIndex);
+  if (!model || !model->NumVertices)
+  {
+    MeshMap[key] = INDEX_NONE;
+    return INDEX_NONE;
+  }
+
+  SceneMesh entry;
+  entry.Mesh = mesh;
+  entry.LodIndex = lodIndex;
+  entry.Positions.resize(model->NumVertices);
+  entry.Normals.resize(model->NumVertices);
+  entry.UVs.resize(model->NumVertices);
+
+  // Read buffers directly. No need to build FStaticVertex for every vertex
+  for (uint32 idx = 0; idx < model->NumVertices; ++idx)
+  {
+    const FStaticMeshVertexBase* v = model->VertexBuffer.GetVertex(idx);
+    entry.Positions[idx] = model->PositionBuffer.Data[idx];
+    entry.Normals[idx] = v->GetTangentZ();
+    entry.UVs[idx] = v->GetUVs(0);
+  }
+
+  const FRawIndexBuffer& indexContainer = model->IndexBuffer;
+  for (const FStaticMeshElement& element : model->Elements)
+  {
+    if (!element.NumTriangles)
+    {
+      continue;
+    }
+    SceneMeshSection& section = entry.Sections.emplace_back();
+    section.Indices.resize(element.NumTriangles * 3);
+    for (uint32 idx = 0; idx < element.NumTriangles * 3; ++idx)
+    {
+      section.Indices[idx] = indexContainer.GetIndex(element.FirstIndex + idx);
+    }
+    if (UMaterialInterface* material = Cast<UMaterialInterface>(element.Material))
+    {
+      section.TextureIndex = GetTextureIndex(material->GetDiffuseTexture());
+      section.Masked = material->GetBlendMode() == EBlendMode::BLEND_Masked;
+    }
+  }
+
+  Meshes.emplace_back(std::move(entry));
+  return MeshMap[key] = (int32)Meshes.size() - 1;
+}
+
+int32 SceneAssembler::GetTextureIndex(UTexture2D* texture)
+{
+  if (!texture)
+  {
+    return INDEX_NONE;
+  }
+  auto it = TextureMap.find(texture);
+  if (it != TextureMap.end())
+  {
+    return it->second;
+  }
+  Textures.push_back(texture);
+  return TextureMap[texture] = (int32)Textures.size() - 1;
+}
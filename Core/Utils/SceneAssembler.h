@@ -0,0 +1,89 @@
+#pragma once
+#include <Tera/Core.h>
+#include <Tera/FStructs.h>
+
+#include <map>
+#include <unordered_map>
+
+class UActor;
+class ULevel;
+class UStaticMesh;
+class UStaticMeshActor;
+class UTexture2D;
+
+// Section of a unique mesh. Indices are relative to the SceneMesh vertex arrays
+struct SceneMeshSection {
+  // Index in SceneAssembler::GetTextures() or INDEX_NONE
+  int32 TextureIndex = INDEX_NONE;
+  bool Masked = false;
+  std::vector<uint32> Indices;
+};
+
+// Geometry of a unique UStaticMesh LOD. Decoded once and shared by all instances
+struct SceneMesh {
+  UStaticMesh* Mesh = nullptr;
+  int32 LodIndex = 0;
+
+  std::vector<FVector> Positions;
+  std::vector<FVector> Normals;
+  std::vector<FVector2D> UVs;
+  std::vector<SceneMeshSection> Sections;
+};
+
+// A placement of a unique mesh in the scene. Transform is in the Unreal space
+struct SceneInstance {
+  UActor* Actor = nullptr;
+  int32 MeshIndex = INDEX_NONE;
+  FVector Location;
+  FRotator Rotation;
+  FVector Scale3D = FVector(1, 1, 1);
+};
+
+// Instances that belong to a single level
+struct SceneLevel {
+  ULevel* Level = nullptr;
+  FString Name;
+  std::vector<int32> Instances;
+};
+
+// Converts level actors to a list of unique geometry, unique textures and instances
+class SceneAssembler {
+public:
+  // Add actors of the level to the scene. Returns index of the level in GetLevels()
+  int32 AddLevel(ULevel* level, const FString& name);
+
+  inline const std::vector<SceneMesh>& GetMeshes() const
+  {
+    return Meshes;
+  }
+
+  inline const std::vector<UTexture2D*>& GetTextures() const
+  {
+    return Textures;
+  }
+
+  inline const std::vector<SceneInstance>& GetInstances() const
+  {
+    return Instances;
+  }
+
+  inline const std::vector<SceneLevel>& GetLevels() const
+  {
+    return Levels;
+  }
+
+private:
+  bool AddStaticMeshActor(UStaticMeshActor* actor, SceneLevel& level);
+
+  int32 GetMeshIndex(UStaticMesh* mesh, int32 lodIndex);
+  int32 GetTextureIndex(UTexture2D* texture);
+
+private:
+  std::vector<SceneMesh> Meshes;
+  std::vector<UTexture2D*> Textures;
+  std::vector<SceneInstance> Instances;
+  std::vector<SceneLevel> Levels;
+
+  std::map<std::pair<UStaticMesh*, int32>, int32> MeshMap;
+  std::unordered_map<UTexture2D*, int32> TextureMap;
+};
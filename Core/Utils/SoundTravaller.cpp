@@ -2,28 +2,101 @@
 #include <Tera/USoundNode.h>
 #include <vorbis/vorbisfile.h>
 
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <ppl.h>
 
-static size_t OggRead(void* ptr, size_t size, size_t nmemb, void* datasource)
+namespace
 {
-  SoundTravaller* travaller = (SoundTravaller*)datasource;
-  return travaller->ReadOgg(ptr, size * nmemb);
-}
+  struct OggMemoryReader {
+    const uint8* Data = nullptr;
+    size_t Size = 0;
+    size_t Offset = 0;
+  };
 
-static int32 OggSeek(void* datasource, ogg_int64_t offset, int whence)
-{
-  SoundTravaller* travaller = (SoundTravaller*)datasource;
-  return travaller->SeekOgg(offset, whence);
-}
+  size_t OggRead(void* ptr, size_t size, size_t nmemb, void* datasource)
+  {
+    OggMemoryReader* reader = (OggMemoryReader*)datasource;
+    size_t sizeToRead = std::min<size_t>(size * nmemb, reader->Size - reader->Offset);
+    memcpy(ptr, reader->Data + reader->Offset, sizeToRead);
+    reader->Offset += sizeToRead;
+    return sizeToRead;
+  }
 
-static int32 OggClose(void* datasource)
-{
-  return 0;
-}
+  int32 OggSeek(void* datasource, ogg_int64_t offset, int whence)
+  {
+    OggMemoryReader* reader = (OggMemoryReader*)datasource;
+    int64 position = 0;
+    switch (whence)
+    {
+    case SEEK_SET:
+      position = offset;
+      break;
 
-static long OggTell(void* datasource)
-{
-  SoundTravaller* travaller = (SoundTravaller*)datasource;
-  return travaller->TellOgg();
+    case SEEK_CUR:
+      position = (int64)reader->Offset + offset;
+      break;
+
+    case SEEK_END:
+      position = (int64)reader->Size + offset;
+      break;
+    }
+    if (position < 0 || position > (int64)reader->Size)
+    {
+      return -1;
+    }
+    reader->Offset = (size_t)position;
+    return 0;
+  }
+
+  int32 OggClose(void* datasource)
+  {
+    return 0;
+  }
+
+  long OggTell(void* datasource)
+  {
+    return (long)((OggMemoryReader*)datasource)->Offset;
+  }
+
+  // Granule position of the last complete page. For a single logical stream it's the total number of samples.
+  int64 GetLastGranulePosition(const uint8* data, size_t size)
+  {
+    const size_t headerSize = 27;
+    if (size < headerSize)
+    {
+      return -1;
+    }
+    for (size_t pos = size - headerSize + 1; pos-- > 0;)
+    {
+      if (data[pos] != 'O' || memcmp(data + pos, "OggS", 4) || data[pos + 4])
+      {
+        continue;
+      }
+      const uint8 segments = data[pos + 26];
+      if (pos + headerSize + segments > size)
+      {
+        continue;
+      }
+      int64 granule = 0;
+      memcpy(&granule, data + pos + 6, sizeof(granule));
+      if (granule != -1)
+      {
+        return granule;
+      }
+    }
+    return -1;
+  }
+
+  struct CachedOggInfo {
+    FILE_OFFSET Size = 0;
+    FSoundInfo Info;
+  };
+
+  std::mutex OggInfoCacheMutex;
+  std::unordered_map<uint64, CachedOggInfo> OggInfoCache;
 }
 
 bool SoundTravaller::Visit(USoundNodeWave* wave)
@@ -39,105 +112,197 @@ bool SoundTravaller::Visit(USoundNodeWave* wave)
     return false;
   }
 
-  FSoundInfo info;
-  GetOggInfo(info);
-
-  if (info.Duration <= 0)
+  // Probe once. The same data may be applied to many waves
+  if (Info.Duration <= 0 && !GetCachedOggInfo(Data.get(), DataSize, Info, Error))
   {
-    Error = "Invalid OGG length!";
     return false;
   }
 
-  wave->PCData.Realloc(DataSize);
-  wave->PCData.ElementCount = DataSize;
-  memcpy(wave->PCData.GetAllocation(), Data, DataSize);
-  wave->PCData.BulkDataFlags = BULKDATA_None;
-  free(wave->ResourceData);
-  wave->ResourceData = nullptr;
-
-  if (wave->SampleRateProperty)
-  {
-    wave->SampleRate = info.SampleRate;
-    wave->SampleRateProperty->Value->GetInt() = wave->SampleRate;
-  }
-
-  if (wave->DurationProperty)
+  if (Info.Duration <= 0)
   {
-    wave->Duration = info.Duration;
-    wave->DurationProperty->Value->GetFloat() = wave->Duration;
-  }
-
-  if (wave->NumChannelsProperty)
-  {
-    wave->NumChannels = info.NumChannels;
-    wave->NumChannelsProperty->Value->GetInt() = wave->NumChannels;
+    Error = "Invalid OGG length!";
+    return false;
   }
 
-  wave->PostLoad();
+  Apply(wave, Data, DataSize, Info);
   wave->MarkDirty();
   return true;
 }
 
-size_t SoundTravaller::ReadOgg(void* ptr, uint32 size)
+bool SoundTravaller::ImportBatch(std::vector<SoundImportTarget>& targets)
 {
-  size_t sizeToRead = std::min<size_t>(size, DataSize - DataOffset);
-  memcpy(ptr, (uint8*)Data + DataOffset, sizeToRead);
-  DataOffset += sizeToRead;
-  return sizeToRead;
-}
+  struct SourceEntry {
+    std::wstring Path;
+    std::shared_ptr<void> Data;
+    FILE_OFFSET Size = 0;
+    FSoundInfo Info;
+    std::string Error;
+  };
 
-int32 SoundTravaller::SeekOgg(uint64 offset, int whence)
-{
-  switch (whence)
+  std::vector<SourceEntry> sources;
+  std::vector<size_t> targetSources(targets.size());
   {
-  case SEEK_SET:
-    DataOffset = offset;
-    break;
+    std::unordered_map<std::wstring, size_t> sourceMap;
+    for (size_t idx = 0; idx < targets.size(); ++idx)
+    {
+      auto it = sourceMap.find(targets[idx].Source);
+      if (it == sourceMap.end())
+      {
+        it = sourceMap.emplace(targets[idx].Source, sources.size()).first;
+        sources.emplace_back().Path = targets[idx].Source;
+      }
+      targetSources[idx] = it->second;
+    }
+  }
 
-  case SEEK_CUR:
-    DataOffset += offset;
-    break;
+  concurrency::parallel_for(size_t(0), sources.size(), [&](size_t idx) {
+    SourceEntry& source = sources[idx];
+    std::ifstream s(source.Path, std::ios::in | std::ios::binary);
+    if (!s.is_open())
+    {
+      source.Error = "Failed to open the file!";
+      return;
+    }
+    s.seekg(0, std::ios::end);
+    source.Size = (FILE_OFFSET)s.tellg();
+    s.seekg(0, std::ios::beg);
+    if (source.Size <= 0)
+    {
+      source.Error = "File is empty!";
+      return;
+    }
+    source.Data = std::shared_ptr<void>(malloc(source.Size), free);
+    if (!s.read((char*)source.Data.get(), source.Size))
+    {
+      source.Error = "Failed to read the file!";
+      source.Data.reset();
+      return;
+    }
+    if (GetCachedOggInfo(source.Data.get(), source.Size, source.Info, source.Error) && source.Info.Duration <= 0)
+    {
+      source.Error = "Invalid OGG length!";
+    }
+  });
 
-  case SEEK_END:
-    DataOffset = DataSize - offset;
-    break;
-  }
+  std::atomic_bool result(true);
+  concurrency::parallel_for(size_t(0), targets.size(), [&](size_t idx) {
+    SoundImportTarget& target = targets[idx];
+    const SourceEntry& source = sources[targetSources[idx]];
+    if (!target.Wave)
+    {
+      target.Error = "No object provided!";
+    }
+    else if (source.Error.size())
+    {
+      target.Error = source.Error;
+    }
+    else
+    {
+      Apply(target.Wave, source.Data, source.Size, source.Info);
+      return;
+    }
+    result = false;
+  });
 
-  return DataOffset;
+  // Package flags are not atomic. Mark objects on this thread
+  for (SoundImportTarget& target : targets)
+  {
+    if (target.Wave && target.Error.empty())
+    {
+      target.Wave->MarkDirty();
+    }
+  }
+  return result;
 }
 
-uint32 SoundTravaller::TellOgg()
+bool SoundTravaller::ProbeOgg(const void* data, FILE_OFFSET size, FSoundInfo& info, std::string& error)
 {
-  return DataOffset;
-}
+  if (!data || size <= 0)
+  {
+    error = "OGG file is empty or corrupted!";
+    return false;
+  }
+
+  OggMemoryReader reader;
+  reader.Data = (const uint8*)data;
+  reader.Size = size;
 
-bool SoundTravaller::GetOggInfo(FSoundInfo& info)
-{
-  OggVorbis_File vf;
   ov_callbacks cb;
   cb.read_func = OggRead;
   cb.seek_func = OggSeek;
   cb.close_func = OggClose;
   cb.tell_func = OggTell;
 
-  DataOffset = 0;
-  if (ov_open_callbacks(this, &vf, nullptr, 0, cb) < 0)
+  // Partial open reads the identification, comment and setup headers only
+  OggVorbis_File vf;
+  if (ov_test_callbacks(&reader, &vf, nullptr, 0, cb) < 0)
   {
-    Error = "Not a valid OGG file!";
+    error = "Not a valid OGG file!";
     return false;
   }
 
-  if (vorbis_info* vi = ov_info(&vf, -1))
+  vorbis_info* vi = ov_info(&vf, -1);
+  if (!vi || vi->rate <= 0)
   {
-    info.SampleRate = vi->rate;
-    info.NumChannels = vi->channels;
-    info.Duration = ov_time_total(&vf, -1);
-
     ov_clear(&vf);
-    return true;
+    error = "Not a valid OGG file!";
+    return false;
   }
+  info.SampleRate = vi->rate;
+  info.NumChannels = vi->channels;
   ov_clear(&vf);
 
-  Error = "Not a valid OGG file!";
-  return false;
+  const int64 samples = GetLastGranulePosition((const uint8*)data, size);
+  info.Duration = samples > 0 ? (float)((double)samples / info.SampleRate) : 0.f;
+  return true;
+}
+
+bool SoundTravaller::GetCachedOggInfo(const void* data, FILE_OFFSET size, FSoundInfo& info, std::string& error)
+{
+  const uint64 hash = HashBuffer(data, size);
+  {
+    std::scoped_lock<std::mutex> lock(OggInfoCacheMutex);
+    auto it = OggInfoCache.find(hash);
+    if (it != OggInfoCache.end() && it->second.Size == size)
+    {
+      info = it->second.Info;
+      return true;
+    }
+  }
+  if (!ProbeOgg(data, size, info, error))
+  {
+    return false;
+  }
+  std::scoped_lock<std::mutex> lock(OggInfoCacheMutex);
+  CachedOggInfo& entry = OggInfoCache[hash];
+  entry.Size = size;
+  entry.Info = info;
+  return true;
+}
+
+void SoundTravaller::Apply(USoundNodeWave* wave, const std::shared_ptr<void>& data, FILE_OFFSET size, const FSoundInfo& info)
+{
+  {
+    std::scoped_lock<std::mutex> lock(wave->ResourceMutex);
+    wave->PCData.SetSharedData(data, size);
+    wave->PCData.BulkDataFlags = BULKDATA_None;
+  }
+
+  if (wave->SampleRateProperty)
+  {
+    wave->SampleRate = info.SampleRate;
+    wave->SampleRateProperty->Value->GetInt() = wave->SampleRate;
+  }
+
+  if (wave->DurationProperty)
+  {
+    wave->Duration = info.Duration;
+    wave->DurationProperty->Value->GetFloat() = wave->Duration;
+  }
+
+  if (wave->NumChannelsProperty)
+  {
+    wave->NumChannels = info.NumChannels;
+    wave->NumChannelsProperty->Value->GetInt() = wave->NumChannels;
+  }
 }
@@ -2,47 +2,56 @@
 #include <Tera/Core.h>
 #include <Tera/FStructs.h>
 
+#include <memory>
+
 class USoundNodeWave;
 
-class SoundTravaller {
-public:
+struct FSoundInfo
+{
+  uint32 NumChannels = 0;
+  uint32 SampleRate = 0;
+  float Duration = 0;
+};
 
-  ~SoundTravaller()
-  {
-    free(Data);
-  }
+// A wave to import an Ogg file to
+struct SoundImportTarget {
+  USoundNodeWave* Wave = nullptr;
+  std::wstring Source;
+
+  std::string Error;
+};
 
+class SoundTravaller {
+public:
   std::string GetError() const
   {
     return Error;
   }
 
+  // Takes ownership of a malloc'ed buffer. Visited waves share it without copying
   void SetData(void* data, FILE_OFFSET size)
   {
-    free(Data);
-    Data = data;
+    Data = std::shared_ptr<void>(data, free);
     DataSize = size;
+    Info = {};
   }
 
   bool Visit(USoundNodeWave* wave);
 
-  size_t ReadOgg(void* ptr, uint32 size);
-  int32 SeekOgg(uint64 offset, int whence);
-  uint32 TellOgg();
+  // Import Ogg files to waves. Every unique source is read and probed once and its targets share a single payload.
+  // Probe results are cached by content. Returns false if any of the targets failed. Check targets for errors.
+  static bool ImportBatch(std::vector<SoundImportTarget>& targets);
 
-private:
-  struct FSoundInfo
-  {
-    uint32 NumChannels = 0;
-    uint32 SampleRate = 0;
-    float Duration = 0;
-  };
+  // Get channels, sample rate and duration. Parses only the stream headers and the last page.
+  static bool ProbeOgg(const void* data, FILE_OFFSET size, FSoundInfo& info, std::string& error);
 
-  bool GetOggInfo(FSoundInfo& info);
+private:
+  static bool GetCachedOggInfo(const void* data, FILE_OFFSET size, FSoundInfo& info, std::string& error);
+  static void Apply(USoundNodeWave* wave, const std::shared_ptr<void>& data, FILE_OFFSET size, const FSoundInfo& info);
 
 private:
   std::string Error;
-  void* Data = nullptr;
+  std::shared_ptr<void> Data;
   FILE_OFFSET DataSize = 0;
-  FILE_OFFSET DataOffset = 0;;
-};
\ No newline at end of file
+  FSoundInfo Info;
+};
@@ -0,0 +1,106 @@
+#include "TextureFileCacheWriter.h"
+#include <Tera/FStream.h>
+
+#include <filesystem>
+
+TextureFileCacheWriter::TextureFileCacheWriter(const FString& path, bool deduplicate)
+  : Path(path)
+  , Deduplicate(deduplicate)
+{
+  std::filesystem::path fspath(path.WString());
+  Name = fspath.stem().wstring();
+  std::error_code err;
+  const bool exists = std::filesystem::exists(fspath, err);
+  Stream = std::make_unique<FWriteStream>(path, !exists);
+  if (!Stream->IsGood())
+  {
+    Error = "Failed to open " + path.UTF8();
+    return;
+  }
+  Stream->SetPosition(Stream->GetSize());
+}
+
+TextureFileCacheWriter::~TextureFileCacheWriter()
+{}
+
+bool TextureFileCacheWriter::IsGood() const
+{
+  std::scoped_lock<std::mutex> lock(StreamMutex);
+  return Stream && Stream->IsGood();
+}
+
+std::string TextureFileCacheWriter::GetError() const
+{
+  std::scoped_lock<std::mutex> lock(StreamMutex);
+  return Error;
+}
+
+bool TextureFileCacheWriter::AddMip(const void* data, int32 size, int32& offsetInFile, int32& sizeOnDisk)
+{
+  if (!data || size <= 0)
+  {
+    return false;
+  }
+
+  const uint64 hash = Deduplicate ? HashBuffer(data, size) : 0;
+  if (Deduplicate)
+  {
+    std::scoped_lock<std::mutex> lock(StreamMutex);
+    auto range = Written.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (it->second.Size == size)
+      {
+        offsetInFile = it->second.OffsetInFile;
+        sizeOnDisk = it->second.SizeOnDisk;
+        return true;
+      }
+    }
+  }
+
+  // Compress outside of the lock. The payload has no absolute offsets, so it can be placed anywhere
+  MWrightStream payload(nullptr, 0);
+  try
+  {
+    payload.SerializeCompressed((void*)data, size, COMPRESS_LZO);
+  }
+  catch (const std::exception& e)
+  {
+    std::scoped_lock<std::mutex> lock(StreamMutex);
+    Error = e.what();
+    return false;
+  }
+
+  std::scoped_lock<std::mutex> lock(StreamMutex);
+  if (!Stream || !Stream->IsGood())
+  {
+    return false;
+  }
+  if (Deduplicate)
+  {
+    // Another thread may have written the same mip while we were compressing
+    auto range = Written.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (it->second.Size == size)
+      {
+        offsetInFile = it->second.OffsetInFile;
+        sizeOnDisk = it->second.SizeOnDisk;
+        return true;
+      }
+    }
+  }
+  offsetInFile = Stream->GetPosition();
+  sizeOnDisk = payload.GetPosition();
+  Stream->SerializeBytes(payload.GetAllocation(), sizeOnDisk);
+  if (!Stream->IsGood())
+  {
+    Error = "Failed to write to " + Path.UTF8();
+    return false;
+  }
+  if (Deduplicate)
+  {
+    Written.emplace(hash, CachedMip{ size, offsetInFile, sizeOnDisk });
+  }
+  return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <Tera/Core.h>
+#include <Tera/FString.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+class FStream;
+
+// Appends LZO compressed mipmaps to a texture file cache (.tfc).
+// Mips are stored the same way the game stores them, so textures can point to the file with
+// BULKDATA_StoreInSeparateFile and their TextureFileCacheName. Safe to use from multiple threads.
+class TextureFileCacheWriter {
+public:
+  // Opens an existing cache or creates a new one. New mips are appended to the end of the file.
+  // Identical payloads are written once if deduplicate is true.
+  TextureFileCacheWriter(const FString& path, bool deduplicate = true);
+  ~TextureFileCacheWriter();
+
+  bool IsGood() const;
+
+  // File name without extension. Textures refer to the cache by this name.
+  FString GetName() const
+  {
+    return Name;
+  }
+
+  FString GetPath() const
+  {
+    return Path;
+  }
+
+  std::string GetError() const;
+
+  // Compress and append the mip. Outputs values for BulkDataOffsetInFile and BulkDataSizeOnDisk.
+  bool AddMip(const void* data, int32 size, int32& offsetInFile, int32& sizeOnDisk);
+
+private:
+  struct CachedMip {
+    int32 Size = 0;
+    int32 OffsetInFile = 0;
+    int32 SizeOnDisk = 0;
+  };
+
+  FString Path;
+  FString Name;
+  bool Deduplicate = true;
+
+  mutable std::mutex StreamMutex;
+  std::unique_ptr<FStream> Stream;
+  std::unordered_multimap<uint64, CachedMip> Written;
+  std::string Error;
+};
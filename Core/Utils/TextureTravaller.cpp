@@ -1,7 +1,9 @@
 #include "TextureTravaller.h"
+#include "TextureFileCacheWriter.h"
 #include <Tera/UTexture.h>
 #include <Tera/FPackage.h>
 #include <Tera/FObjectResource.h>
+#include <Tera/ALog.h>
 
 void TextureTravaller::SetFormat(EPixelFormat format)
 {
@@ -40,6 +42,11 @@ void TextureTravaller::AddMipMap(int32 sizeX, int32 sizeY, int32 size, void* dat
   Mips.push_back({ sizeX, sizeY, size, data });
 }
 
+void TextureTravaller::SetTextureFileCache(TextureFileCacheWriter* cache)
+{
+  TextureFileCache = cache;
+}
+
 std::string TextureTravaller::GetError() const
 {
   return Error;
@@ -112,7 +119,14 @@ bool TextureTravaller::Visit(UTexture2D* texture)
     }
   }
 
-  if (texture->TextureFileCacheNameProperty)
+  // Small mips stay in the package like the game's mip tail
+  const int32 minCachedMipSize = 64;
+  bool useCache = TextureFileCache && TextureFileCache->IsGood() && Mips[0].SizeX >= minCachedMipSize && Mips[0].SizeY >= minCachedMipSize;
+  if (useCache)
+  {
+    useCache = texture->SetTextureFileCacheName(TextureFileCache->GetName());
+  }
+  else if (texture->TextureFileCacheNameProperty)
   {
     texture->RemoveProperty(texture->TextureFileCacheNameProperty);
     texture->TextureFileCacheName = nullptr;
@@ -142,6 +156,23 @@ bool TextureTravaller::Visit(UTexture2D* texture)
     memcpy(data, tmip.Data, tmip.Size);
     mip->Data = new FByteBulkData(texture->GetPackage(), BULKDATA_None, tmip.Size, data, true);
     texture->Mips.push_back(mip);
+
+    if (useCache && tmip.SizeX >= minCachedMipSize && tmip.SizeY >= minCachedMipSize)
+    {
+      int32 offsetInFile = 0;
+      int32 sizeOnDisk = 0;
+      if (TextureFileCache->AddMip(tmip.Data, tmip.Size, offsetInFile, sizeOnDisk))
+      {
+        // The payload stays in memory for previews. Saving writes only the location
+        mip->Data->BulkDataFlags = BULKDATA_StoreInSeparateFile | BULKDATA_SerializeCompressedLZO;
+        mip->Data->BulkDataOffsetInFile = offsetInFile;
+        mip->Data->BulkDataSizeOnDisk = sizeOnDisk;
+      }
+      else
+      {
+        LogW("Failed to cache %dx%d mip of %s: %s", tmip.SizeX, tmip.SizeY, texture->GetObjectName().C_str(), TextureFileCache->GetError().c_str());
+      }
+    }
   }
   
   texture->MarkDirty();
@@ -3,6 +3,7 @@
 #include <Tera/FStructs.h>
 
 class UTexture2D;
+class TextureFileCacheWriter;
 class TextureTravaller {
 public:
   void SetFormat(EPixelFormat format);
@@ -14,6 +15,9 @@ public:
   void SetRawData(void* data, int32 size, bool transferOwnership = false);
   void AddMipMap(int32 sizeX, int32 sizeY, int32 size, void* data);
 
+  // Store large mips in a texture file cache instead of the package. The writer must outlive Visit calls.
+  void SetTextureFileCache(TextureFileCacheWriter* cache);
+
   std::string GetError() const;
 
   bool Visit(UTexture2D* texture);
@@ -34,6 +38,7 @@ private:
   TextureAddress AddressY = TA_Wrap;
   TextureCompressionSettings Compression = TC_Default;
   bool SRGB = false;
+  TextureFileCacheWriter* TextureFileCache = nullptr;
 
   bool OwnsData = false;
   uint8* Data = nullptr;